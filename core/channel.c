@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_channel
+ * @{
+ *
+ * @file
+ * @brief       Channel implementation
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "channel.h"
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifdef MODULE_CORE_CHANNEL
+
+static inline channel_slot_hdr_t *_slot(channel_t *chan, unsigned count)
+{
+    return (channel_slot_hdr_t *)&chan->buf[(count & chan->cib.mask) *
+                                            chan->stride];
+}
+
+static void _wake_waiter(list_node_t *wait_list, unsigned irqstate)
+{
+    list_node_t *next = list_remove_head(wait_list);
+
+    if (next == NULL) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
+    sched_set_status(thread, STATUS_PENDING);
+
+    DEBUG("channel: Thread %"PRIkernel_pid": _wake_waiter(): waking up "
+          "%"PRIkernel_pid".\n", sched_active_pid, thread->pid);
+
+    uint16_t process_priority = thread->priority;
+    irq_restore(irqstate);
+    sched_switch(process_priority);
+}
+
+static unsigned _wait(list_node_t *wait_list, unsigned irqstate)
+{
+    DEBUG("channel: Thread %"PRIkernel_pid" _wait(): going blocked.\n",
+          sched_active_pid);
+
+    thread_t *me = (thread_t*) sched_active_thread;
+    sched_set_status(me, STATUS_CHANNEL_BLOCKED);
+    thread_add_to_list(wait_list, me);
+    irq_restore(irqstate);
+    thread_yield_higher();
+
+    DEBUG("channel: Thread %"PRIkernel_pid" _wait(): woke up.\n",
+          sched_active_pid);
+    return irq_disable();
+}
+
+void *_channel_reserve(channel_t *chan, int blocking)
+{
+    unsigned irqstate = irq_disable();
+
+    while (cib_full(&chan->cib)) {
+        if (!blocking || irq_is_in()) {
+            irq_restore(irqstate);
+            return NULL;
+        }
+        irqstate = _wait(&chan->writers, irqstate);
+    }
+
+    channel_slot_hdr_t *slot = _slot(chan, chan->cib.write_count);
+    irq_restore(irqstate);
+
+    return slot + 1;
+}
+
+void channel_commit(channel_t *chan, size_t len)
+{
+    assert(len <= chan->size);
+
+    unsigned irqstate = irq_disable();
+
+    assert(!cib_full(&chan->cib));
+    _slot(chan, chan->cib.write_count)->len = len;
+    cib_put_unsafe(&chan->cib);
+
+    DEBUG("channel: Thread %"PRIkernel_pid" channel 0x%08x: commit(): "
+          "%u bytes.\n", sched_active_pid, (unsigned)chan, (unsigned)len);
+    _wake_waiter(&chan->readers, irqstate);
+}
+
+void *_channel_peek(channel_t *chan, size_t *len, int blocking)
+{
+    unsigned irqstate = irq_disable();
+
+    while (cib_avail(&chan->cib) == 0) {
+        if (!blocking || irq_is_in()) {
+            irq_restore(irqstate);
+            return NULL;
+        }
+        irqstate = _wait(&chan->readers, irqstate);
+    }
+
+    channel_slot_hdr_t *slot = _slot(chan, chan->cib.read_count);
+    irq_restore(irqstate);
+
+    if (len) {
+        *len = slot->len;
+    }
+    return slot + 1;
+}
+
+void channel_consume(channel_t *chan)
+{
+    unsigned irqstate = irq_disable();
+
+    assert(cib_avail(&chan->cib) > 0);
+    cib_get_unsafe(&chan->cib);
+
+    DEBUG("channel: Thread %"PRIkernel_pid" channel 0x%08x: consume().\n",
+          sched_active_pid, (unsigned)chan);
+    _wake_waiter(&chan->writers, irqstate);
+}
+
+#endif /* MODULE_CORE_CHANNEL */
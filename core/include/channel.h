@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_channel Channels
+ * @ingroup     core
+ * @brief       Zero-copy slot ring for passing large payloads between threads
+ *
+ * A channel is a ring of fixed size slots shared by one producer and one
+ * consumer. Unlike @ref msg_t, which can carry at most a pointer, the
+ * payload is written directly into the channel's memory and read from
+ * there, so no separately managed buffer and ownership handshake is needed.
+ *
+ * The producer reserves the next free slot, fills it and commits it. The
+ * consumer peeks at the oldest committed slot, processes it in place and
+ * consumes it, which makes the slot available to the producer again.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static uint8_t buf[CHANNEL_BUF_SIZE(4, 256)];
+ * static channel_t chan = CHANNEL_INIT(buf, 4, 256);
+ *
+ * // producer
+ * uint8_t *slot = channel_reserve(&chan);
+ * size_t len = fill(slot, 256);
+ * channel_commit(&chan, len);
+ *
+ * // consumer
+ * size_t len;
+ * uint8_t *slot = channel_peek(&chan, &len);
+ * process(slot, len);
+ * channel_consume(&chan);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Like msg_send(), the blocking functions never block when called from an
+ * interrupt but behave like their `try` counterparts, so an ISR can act as
+ * the producer using channel_try_reserve() and channel_commit().
+ *
+ * @note    At most one slot may be reserved and at most one slot may be
+ *          peeked at at any given time.
+ * @{
+ *
+ * @file
+ * @brief       Channel API
+ */
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "list.h"
+#include "cib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Header in front of every channel slot
+ */
+typedef struct {
+    size_t len;             /**< number of committed payload bytes  */
+} channel_slot_hdr_t;
+
+/**
+ * @brief   Memory needed for one slot with a payload of @p size bytes
+ */
+#define CHANNEL_SLOT_SIZE(size) (sizeof(channel_slot_hdr_t) + \
+                                 (((size) + sizeof(size_t) - 1) & \
+                                  ~(sizeof(size_t) - 1)))
+
+/**
+ * @brief   Memory needed for a channel of @p num slots with a payload of
+ *          @p size bytes each
+ */
+#define CHANNEL_BUF_SIZE(num, size) ((num) * CHANNEL_SLOT_SIZE(size))
+
+/**
+ * @brief   Static initializer for channel objects
+ */
+#define CHANNEL_INIT(buf, num, size) { {0}, {0}, CIB_INIT(num), \
+                                       (uint8_t *)(buf), (size), \
+                                       CHANNEL_SLOT_SIZE(size) }
+
+/**
+ * @brief   Channel struct definition
+ */
+typedef struct {
+    list_node_t readers;    /**< list of threads waiting for a slot to read  */
+    list_node_t writers;    /**< list of threads waiting for a free slot     */
+    cib_t cib;              /**< committed (write) and consumed (read) slots */
+    uint8_t *buf;           /**< slot memory                                 */
+    size_t size;            /**< maximum payload size of a slot              */
+    size_t stride;          /**< distance between two slots in @p buf        */
+} channel_t;
+
+/**
+ * @brief   Initialize channel object
+ *
+ * @note    The number of slots must be a power of two!
+ *
+ * @param[out] chan     channel to initialize
+ * @param[in]  buf      slot memory of at least
+ *                      CHANNEL_BUF_SIZE(@p num, @p size) bytes, aligned
+ *                      for `size_t`
+ * @param[in]  num      number of slots
+ * @param[in]  size     maximum payload size of a slot in bytes
+ */
+static inline void channel_init(channel_t *chan, void *buf, unsigned num,
+                                size_t size)
+{
+    channel_t c = CHANNEL_INIT(buf, num, size);
+    *chan = c;
+}
+
+/**
+ * @brief   Reserve the next free slot
+ *
+ * @internal
+ *
+ * @param[in] chan      channel to operate on
+ * @param[in] blocking  block if 1, don't block if 0
+ *
+ * @return  pointer to @ref channel_t::size bytes of payload memory
+ * @return  NULL if the channel is full and @p blocking is 0
+ */
+void *_channel_reserve(channel_t *chan, int blocking);
+
+/**
+ * @brief   Get the oldest committed slot
+ *
+ * @internal
+ *
+ * @param[in]  chan     channel to operate on
+ * @param[out] len      number of bytes committed to the slot, may be NULL
+ * @param[in]  blocking block if 1, don't block if 0
+ *
+ * @return  pointer to the slot's payload
+ * @return  NULL if the channel is empty and @p blocking is 0
+ */
+void *_channel_peek(channel_t *chan, size_t *len, int blocking);
+
+/**
+ * @brief   Reserve the next free slot, blocking
+ *
+ * If all slots are in use, this function blocks until the consumer consumed
+ * one.
+ *
+ * @param[in] chan  channel to operate on
+ *
+ * @return  pointer to @ref channel_t::size bytes of payload memory
+ * @return  NULL if called from an interrupt and the channel is full
+ */
+static inline void *channel_reserve(channel_t *chan)
+{
+    return _channel_reserve(chan, 1);
+}
+
+/**
+ * @brief   Reserve the next free slot, non-blocking
+ *
+ * @param[in] chan  channel to operate on
+ *
+ * @return  pointer to @ref channel_t::size bytes of payload memory
+ * @return  NULL if the channel is full
+ */
+static inline void *channel_try_reserve(channel_t *chan)
+{
+    return _channel_reserve(chan, 0);
+}
+
+/**
+ * @brief   Commit the slot returned by the last reservation
+ *
+ * Makes the slot visible to the consumer and wakes it up if it is waiting.
+ * May be called from an interrupt.
+ *
+ * @param[in] chan  channel to operate on
+ * @param[in] len   number of payload bytes written, must not exceed
+ *                  @ref channel_t::size
+ */
+void channel_commit(channel_t *chan, size_t len);
+
+/**
+ * @brief   Get the oldest committed slot, blocking
+ *
+ * If no slot is committed, this function blocks until the producer commits
+ * one. The slot stays valid until channel_consume() is called.
+ *
+ * @param[in]  chan     channel to operate on
+ * @param[out] len      number of bytes committed to the slot, may be NULL
+ *
+ * @return  pointer to the slot's payload
+ * @return  NULL if called from an interrupt and the channel is empty
+ */
+static inline void *channel_peek(channel_t *chan, size_t *len)
+{
+    return _channel_peek(chan, len, 1);
+}
+
+/**
+ * @brief   Get the oldest committed slot, non-blocking
+ *
+ * @param[in]  chan     channel to operate on
+ * @param[out] len      number of bytes committed to the slot, may be NULL
+ *
+ * @return  pointer to the slot's payload
+ * @return  NULL if the channel is empty
+ */
+static inline void *channel_try_peek(channel_t *chan, size_t *len)
+{
+    return _channel_peek(chan, len, 0);
+}
+
+/**
+ * @brief   Release the slot returned by the last peek
+ *
+ * Makes the slot available to the producer again and wakes it up if it is
+ * waiting for a free slot. May be called from an interrupt.
+ *
+ * @param[in] chan  channel to operate on
+ */
+void channel_consume(channel_t *chan);
+
+/**
+ * @brief   Get number of committed slots not yet consumed
+ *
+ * @param[in] chan  channel to operate on
+ *
+ * @return  number of slots available to the consumer
+ */
+static inline unsigned channel_avail(channel_t *chan)
+{
+    return cib_avail(&chan->cib);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* CHANNEL_H */
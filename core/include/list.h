@@ -21,6 +21,8 @@
 #ifndef LIST_H
 #define LIST_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,6 +71,29 @@ static inline list_node_t* list_remove_head(list_node_t *list) {
     return head;
 }
 
+/**
+ * @brief Removes the node from the list
+ *
+ * @note Complexity: O(n)
+ *
+ * @param[in] list  Pointer to the list itself, where list->next points
+ *                  to the root node
+ * @param[in] node  List node to remove from the list
+ *
+ * @return  removed node, or NULL if @p node was not found in the list
+ */
+static inline list_node_t *list_remove(list_node_t *list, list_node_t *node)
+{
+    while (list->next) {
+        if (list->next == node) {
+            list->next = node->next;
+            return node;
+        }
+        list = list->next;
+    }
+    return NULL;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -231,6 +231,25 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send a burst of messages (non-blocking).
+ *
+ * Sends the messages in @p m to another thread in one critical section. If
+ * the target is waiting for a message, the first one is delivered directly,
+ * all following messages are put into the target's message queue until it is
+ * full. This function never blocks and may be called from an interrupt.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t``
+ *                          structures, must not be NULL.
+ * @param[in] num           Number of messages in @p m
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return number of messages delivered, the messages in @p m are delivered
+ *         in order so the remaining ones start at `m[return value]`
+ * @return -1, on error (invalid PID)
+ */
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 
 /**
  * @brief Send a message to the current thread.
@@ -309,6 +328,35 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive a burst of messages.
+ *
+ * This function blocks until at least one message was received. All messages
+ * that are pending at that point, up to @p max, are then received within a
+ * single critical section, which saves the per-message overhead of
+ * msg_receive() for threads processing messages in bursts.
+ *
+ * @param[out] buf  Array of at least @p max preallocated ``msg_t`` structures,
+ *                  must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received into @p buf (at least 1)
+ */
+unsigned msg_receive_bulk(msg_t *buf, unsigned max);
+
+/**
+ * @brief Try to receive a burst of messages.
+ *
+ * Like msg_receive_bulk(), but does not block if no message is pending.
+ *
+ * @param[out] buf  Array of at least @p max preallocated ``msg_t`` structures,
+ *                  must not be NULL.
+ * @param[in] max   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received into @p buf, 0 if none was pending
+ */
+unsigned msg_try_receive_bulk(msg_t *buf, unsigned max);
+
 /**
  * @brief Send a message, block until reply received.
  *
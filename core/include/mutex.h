@@ -11,6 +11,13 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * If the (pseudo) module `core_mutex_priority_inheritance` is used, a thread
+ * blocking on a mutex lends its priority to the thread holding the mutex for
+ * as long as the mutex is held. The boost is passed on through chains of
+ * threads that are themselves blocked on another mutex, so a high priority
+ * thread is never kept waiting by medium priority threads that preempt a
+ * low priority mutex holder.
  * @{
  *
  * @file
@@ -26,6 +33,7 @@
 
 #include "list.h"
 #include "atomic.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -41,13 +49,29 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   PID of the thread currently holding the mutex
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in the owner's list of held mutexes
+     * @internal
+     */
+    list_node_t owner_entry;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Initializes a mutex object.
@@ -58,6 +82,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owner_entry.next = NULL;
+#endif
 }
 
 /**
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_util
+ * @{
+ *
+ * @file
+ * @brief       A priority queue with logarithmic insertion and removal
+ *
+ * Drop-in alternative to @ref priority_queue.h for queues that may grow
+ * long. It is implemented as an intrusive pairing heap: peeking at the head
+ * is O(1), adding is O(1) and removing the head or any node is O(log n)
+ * amortized, while priority_queue_add() walks the whole list.
+ *
+ * Like for priority_queue_t, nodes with lower priority values come first
+ * and nodes of equal priority are returned in the order they were added.
+ * Unlike for priority_queue_t, only the head (@ref priority_heap_t::first)
+ * may be accessed directly, the remaining nodes are not stored in order.
+ */
+
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief data type for priority heap nodes
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *child;   /**< first child node */
+    struct priority_heap_node *next;    /**< next sibling node */
+    struct priority_heap_node *prev;    /**< previous sibling node, or parent
+                                             for the first child */
+    uint32_t priority;                  /**< heap node priority */
+    uint32_t seq;                       /**< insertion order, set by the heap */
+    unsigned int data;                  /**< heap node data */
+} priority_heap_node_t;
+
+/**
+ * @brief data type for priority heaps
+ */
+typedef struct {
+    priority_heap_node_t *first;        /**< head of the heap */
+    uint32_t seq;                       /**< insertion counter */
+} priority_heap_t;
+
+/**
+ * @brief Static initializer for priority_heap_node_t.
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, NULL, NULL, 0, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap node object.
+ * @details For initialization of variables use PRIORITY_HEAP_NODE_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heap nodes.
+ * @param[out] priority_heap_node
+ *          pre-allocated priority_heap_node_t object, must not be NULL.
+ */
+static inline void priority_heap_node_init(
+        priority_heap_node_t *priority_heap_node)
+{
+    priority_heap_node_t hn = PRIORITY_HEAP_NODE_INIT;
+    *priority_heap_node = hn;
+}
+
+/**
+ * @brief Static initializer for priority_heap_t.
+ */
+#define PRIORITY_HEAP_INIT { NULL, 0 }
+
+/**
+ * @brief   Initialize a priority heap object.
+ * @details For initialization of variables use PRIORITY_HEAP_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heaps.
+ * @param[out] priority_heap
+ *          pre-allocated priority_heap_t object, must not be NULL.
+ */
+static inline void priority_heap_init(priority_heap_t *priority_heap)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+    *priority_heap = h;
+}
+
+/**
+ * @brief get the priority heap's head without removing it
+ *
+ * @param[in]   root    the heap's root
+ *
+ * @return              the head, or NULL if the heap is empty
+ */
+static inline priority_heap_node_t *priority_heap_peek(priority_heap_t *root)
+{
+    return root->first;
+}
+
+/**
+ * @brief remove the priority heap's head
+ *
+ * @param[out]  root    the heap's root
+ *
+ * @return              the old head
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *root);
+
+/**
+ * @brief insert `new_obj` into `root` based on its priority
+ *
+ * @details
+ * The new object will be returned after objects with the same priority.
+ *
+ * @param[in,out]   root    the heap's root
+ * @param[in]       new_obj the object to insert
+ *
+ * @pre The heap does not already contain @p new_obj.
+ */
+void priority_heap_add(priority_heap_t *root, priority_heap_node_t *new_obj);
+
+/**
+ * @brief remove `node` from `root`
+ *
+ * Does nothing if @p node was already removed from the heap.
+ *
+ * @param[in,out]   root    the priority heap's root
+ * @param[in]       node    the node to remove
+ *
+ * @pre @p node was added to @p root before or was initialized.
+ */
+void priority_heap_remove(priority_heap_t *root, priority_heap_node_t *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* PRIORITY_HEAP_H */
@@ -80,6 +80,41 @@ int ringbuffer_add_one(ringbuffer_t *__restrict rb, char c);
  */
 unsigned ringbuffer_add(ringbuffer_t *__restrict rb, const char *buf, unsigned n);
 
+/**
+ * @brief           Get the contiguous free space at the end of the ringbuffer.
+ * @details         Lets a producer write directly into the ringbuffer: write
+ *                  at most the returned number of elements to @p span, then
+ *                  call ringbuffer_commit(). The free space may consist of
+ *                  two spans, the second one is returned after the first one
+ *                  was committed.
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[out]      span  Start of the free space.
+ * @returns         Number of elements that can be written to @p span,
+ *                  0 if rb is full.
+ */
+unsigned ringbuffer_peek_span(ringbuffer_t *__restrict rb, char **span);
+
+/**
+ * @brief           Add elements written to the span returned by
+ *                  ringbuffer_peek_span().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, must not exceed the
+ *                        value returned by ringbuffer_peek_span().
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
+/**
+ * @brief           Get the oldest contiguous elements of the ringbuffer.
+ * @details         Lets a consumer read directly from the ringbuffer: process
+ *                  at most the returned number of elements at @p span, then
+ *                  call ringbuffer_remove().
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      span  Start of the oldest element.
+ * @returns         Number of elements that can be read from @p span,
+ *                  0 if rb is empty.
+ */
+unsigned ringbuffer_get_span(const ringbuffer_t *__restrict rb, char **span);
+
 /**
  * @brief           Peek and remove oldest element from the ringbuffer.
  * @param[in,out]   rb   Ringbuffer to operate on.
@@ -98,6 +133,8 @@ unsigned ringbuffer_get(ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
 /**
  * @brief           Remove a number of elements from the ringbuffer.
+ * @details         The oldest elements are removed, so this can be used to
+ *                  consume the elements returned by ringbuffer_get_span().
  * @param[in,out]   rb    Ringbuffer to operate on.
  * @param[in]       n     Read at most n elements.
  * @returns         Number of elements actually removed.
@@ -119,6 +119,22 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of the specified process
+ *
+ * If the thread is on a run queue, it is moved to the run queue of its new
+ * priority. The currently active thread is put in front of its new run queue,
+ * any other thread is appended to it.
+ *
+ * @note    Must be called with interrupts disabled. The caller is responsible
+ *          to call sched_switch() if appropriate.
+ *
+ * @param[in]   process     Pointer to the thread control block of the
+ *                          targeted process
+ * @param[in]   priority    The new priority of this thread
+ */
+void sched_change_priority(thread_t *process, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -175,6 +191,29 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 NORETURN void sched_task_exit(void);
 
 #ifdef MODULE_SCHEDSTATISTICS
+/**
+ * @name    Scheduler statistics time source
+ *
+ * By default the scheduler statistics are taken with xtimer_now(). A CPU
+ * with a cheaper free running counter (e.g. a cycle counter) can define
+ * SCHEDSTAT_NOW() and SCHEDSTAT_HZ in its cpu_conf.h to use that instead.
+ * The counter must count upwards and wrap around at 2^32.
+ * @{
+ */
+#ifndef SCHEDSTAT_HZ
+#define SCHEDSTAT_HZ            (1000000UL)
+#endif
+/** @} */
+
+/**
+ * @brief   Length of the window for CPU usage in SCHEDSTAT_HZ ticks
+ *
+ * The CPU usage per thread is taken over the last one to two windows.
+ */
+#ifndef SCHEDSTAT_WINDOW
+#define SCHEDSTAT_WINDOW        (SCHEDSTAT_HZ)
+#endif
+
 /**
  *  Scheduler statistics
  */
@@ -183,6 +222,8 @@ typedef struct {
                                          scheduled to run */
     unsigned int schedules;         /**< How often the thread was scheduled to run */
     unsigned long runtime_ticks;    /**< The total runtime of this thread in ticks */
+    unsigned long window_ticks;     /**< Runtime in the current window */
+    unsigned long last_window_ticks; /**< Runtime in the previous window */
 } schedstat;
 
 /**
@@ -190,12 +231,102 @@ typedef struct {
  */
 extern schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 
+/**
+ * @brief   Start of the current CPU usage window
+ */
+extern uint32_t schedstat_window_start;
+
+/**
+ * @brief   Length of the previous CPU usage window, 0 if there is none yet
+ */
+extern uint32_t schedstat_last_window;
+
+/**
+ * @brief   Read the scheduler statistics time source
+ *
+ * @return  current time in SCHEDSTAT_HZ ticks
+ */
+uint32_t schedstat_now(void);
+
 /**
  *  @brief  Register a callback that will be called on every scheduler run
  *
  *  @param[in] callback The callback functions the will be called
  */
 void sched_register_cb(void (*callback)(uint32_t, uint32_t));
+
+#if defined(MODULE_SCHEDSTATISTICS_TRACE) || defined(DOXYGEN)
+/**
+ * @brief   Number of entries in the trace ring, must be a power of two
+ */
+#ifndef SCHEDSTAT_TRACE_SIZE
+#define SCHEDSTAT_TRACE_SIZE    (64U)
+#endif
+
+/**
+ * @brief   Reasons for a trace entry
+ */
+enum {
+    SCHEDSTAT_TRACE_SWITCH = 0,     /**< context switch from `from` to `to` */
+    SCHEDSTAT_TRACE_IRQ,            /**< interrupt `to` while `from` ran */
+    SCHEDSTAT_TRACE_MSG_SEND,       /**< `from` blocked sending to `to` */
+    SCHEDSTAT_TRACE_MSG_RECEIVE,    /**< `from` blocked receiving */
+    SCHEDSTAT_TRACE_MSG_REPLY,      /**< `from` blocked waiting for a reply
+                                         from `to` */
+};
+
+/**
+ * @brief   Trace ring entry
+ */
+typedef struct {
+    uint32_t time;                  /**< SCHEDSTAT_HZ time stamp */
+    kernel_pid_t from;              /**< thread running when recorded */
+    kernel_pid_t to;                /**< next thread, peer thread or IRQ */
+    uint8_t reason;                 /**< one of SCHEDSTAT_TRACE_* */
+} schedstat_trace_t;
+
+/**
+ * @brief   Trace ring, the entry for event n is at
+ *          `n & (SCHEDSTAT_TRACE_SIZE - 1)`
+ */
+extern schedstat_trace_t schedstat_trace_ring[SCHEDSTAT_TRACE_SIZE];
+
+/**
+ * @brief   Number of events recorded since boot
+ */
+extern unsigned schedstat_trace_count;
+
+/**
+ * @brief   Record an event in the trace ring
+ *
+ * May be called from interrupt context.
+ *
+ * @param[in] reason    one of SCHEDSTAT_TRACE_*
+ * @param[in] from      thread running when the event happened
+ * @param[in] to        next thread, peer thread or IRQ number
+ */
+void schedstat_trace(uint8_t reason, kernel_pid_t from, kernel_pid_t to);
+
+#if defined(CPU_NATIVE) || defined(DOXYGEN)
+/**
+ * @brief   Write the trace ring to a file on the host
+ *
+ * The file starts with the header "RIOTTRC" followed by a version byte,
+ * then SCHEDSTAT_HZ, the number of entries, the size of one entry
+ * (each as uint32_t) and finally the entries in chronological order as
+ * schedstat_trace_t, all in host byte order. dist/tools/schedtrace turns
+ * it into a timeline.
+ *
+ * @note    Only available on native.
+ *
+ * @param[in] path  file to write
+ *
+ * @return  number of entries written
+ * @return  -1 if the file could not be written
+ */
+int schedstat_trace_dump(const char *path);
+#endif
+#endif /* MODULE_SCHEDSTATISTICS_TRACE */
 #endif /* MODULE_SCHEDSTATISTICS */
 
 #ifdef __cplusplus
@@ -150,6 +150,7 @@
 #define STATUS_FLAG_BLOCKED_ANY     6   /**< waiting for any flag from flag_mask*/
 #define STATUS_FLAG_BLOCKED_ALL     7   /**< waiting for all flags in flag_mask */
 #define STATUS_MBOX_BLOCKED         8   /**< waiting for get/put on mbox        */
+#define STATUS_CHANNEL_BLOCKED      9   /**< waiting for a channel slot         */
 /** @} */
 
 /**
@@ -157,8 +158,8 @@
  * @{*/
 #define STATUS_ON_RUNQUEUE      STATUS_RUNNING  /**< to check if on run queue:
                                                  `st >= STATUS_ON_RUNQUEUE`             */
-#define STATUS_RUNNING          9               /**< currently running                  */
-#define STATUS_PENDING         10               /**< waiting to be scheduled to run     */
+#define STATUS_RUNNING         10               /**< currently running                  */
+#define STATUS_PENDING         11               /**< waiting to be scheduled to run     */
 /** @} */
 /** @} */
 
@@ -179,9 +180,14 @@ struct _thread {
     clist_node_t rq_entry;          /**< run queue entry                */
 
 #if defined(MODULE_CORE_MSG) || defined(MODULE_CORE_THREAD_FLAGS) \
-    || defined(MODULE_CORE_MBOX)
-    void *wait_data;                /**< used by msg, mbox and thread
-                                         flags                          */
+    || defined(MODULE_CORE_MBOX) || defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE)
+    void *wait_data;                /**< used by msg, mbox, mutex and
+                                         thread flags                   */
+#endif
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    uint8_t base_priority;          /**< priority without inherited
+                                         boosts                         */
+    list_node_t held_mutexes;       /**< mutexes held by this thread    */
 #endif
 #if defined(MODULE_CORE_MSG)
     list_node_t msg_waiters;        /**< threads waiting on message     */
@@ -50,6 +50,10 @@ static int queue_msg(thread_t *target, const msg_t *m)
     DEBUG("queue_msg(): queuing message\n");
     msg_t *dest = &target->msg_array[n];
     *dest = *m;
+#ifdef MODULE_CORE_THREAD_FLAGS
+    target->flags |= THREAD_FLAG_MSG_WAITING;
+    thread_flags_wake(target);
+#endif
     return 1;
 }
 
@@ -108,10 +112,20 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
             DEBUG("msg_send() %s:%i: Target %" PRIkernel_pid
                   " has a msg_queue. Queueing message.\n", RIOT_FILE_RELATIVE,
                   __LINE__, target_pid);
+#ifdef MODULE_CORE_THREAD_FLAGS
+            /* the target might have been woken up by THREAD_FLAG_MSG_WAITING */
+            int target_runnable = (target->status >= STATUS_ON_RUNQUEUE);
+            uint16_t target_prio = target->priority;
+#endif
             irq_restore(state);
             if (me->status == STATUS_REPLY_BLOCKED) {
                 thread_yield_higher();
             }
+#ifdef MODULE_CORE_THREAD_FLAGS
+            else if (target_runnable) {
+                sched_switch(target_prio);
+            }
+#endif
             return 1;
         }
 
@@ -137,6 +151,11 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         }
 
         sched_set_status((thread_t*) me, newstatus);
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+        if (newstatus == STATUS_SEND_BLOCKED) {
+            schedstat_trace(SCHEDSTAT_TRACE_MSG_SEND, me->pid, target_pid);
+        }
+#endif
 
         thread_add_to_list(&(target->msg_waiters), me);
 
@@ -204,7 +223,14 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
     else {
         DEBUG("msg_send_int: Receiver not waiting.\n");
-        return (queue_msg(target, m));
+        int res = queue_msg(target, m);
+#ifdef MODULE_CORE_THREAD_FLAGS
+        /* the target might have been woken up by THREAD_FLAG_MSG_WAITING */
+        if (res && (target->status >= STATUS_ON_RUNQUEUE)) {
+            sched_context_switch_request = 1;
+        }
+#endif
+        return res;
     }
 }
 
@@ -214,6 +240,9 @@ int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
     unsigned state = irq_disable();
     thread_t *me = (thread_t*) sched_threads[sched_active_pid];
     sched_set_status(me, STATUS_REPLY_BLOCKED);
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+    schedstat_trace(SCHEDSTAT_TRACE_MSG_REPLY, me->pid, target_pid);
+#endif
     me->wait_data = (void*) reply;
 
     /* we re-use (abuse) reply for sending, because wait_data might be
@@ -316,6 +345,10 @@ static int _msg_receive(msg_t *m, int block)
             DEBUG("_msg_receive(): %" PRIkernel_pid ": No msg in queue. Going blocked.\n",
                   sched_active_thread->pid);
             sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+            schedstat_trace(SCHEDSTAT_TRACE_MSG_RECEIVE, me->pid,
+                            KERNEL_PID_UNDEF);
+#endif
 
             irq_restore(state);
             thread_yield_higher();
@@ -363,6 +396,160 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+/**
+ * @brief   Moves up to @p max messages pending for @p me into @p buf
+ *
+ * Queued messages are taken first. Senders blocked on a full (or missing)
+ * queue are then either received directly into @p buf or moved into the
+ * queue slots that were just freed.
+ *
+ * @note    Must be called with interrupts disabled.
+ *
+ * @return  number of messages written to @p buf
+ */
+static unsigned _msg_drain(thread_t *me, msg_t *buf, unsigned max,
+                           uint16_t *sender_prio)
+{
+    unsigned n = 0;
+    int queue_index;
+
+    while ((n < max) && me->msg_array
+           && ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+        buf[n++] = me->msg_array[queue_index];
+    }
+
+    while (me->msg_waiters.next) {
+        msg_t *dest;
+
+        if (n < max) {
+            dest = &buf[n++];
+        }
+        else if (me->msg_array && !cib_full(&(me->msg_queue))) {
+            dest = &(me->msg_array[cib_put(&(me->msg_queue))]);
+        }
+        else {
+            break;
+        }
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+        thread_t *sender = container_of((clist_node_t*)next, thread_t, rq_entry);
+        *dest = *((msg_t*) sender->wait_data);
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < *sender_prio) {
+                *sender_prio = sender->priority;
+            }
+        }
+    }
+
+    return n;
+}
+
+static unsigned _msg_receive_bulk(msg_t *buf, unsigned max, int block)
+{
+    assert(max > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t*) sched_threads[sched_active_pid];
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+
+    DEBUG("msg_receive_bulk: %" PRIkernel_pid ": receiving up to %u messages.\n",
+          sched_active_thread->pid, max);
+
+    unsigned n = _msg_drain(me, buf, max, &sender_prio);
+
+    if ((n == 0) && block) {
+        DEBUG("msg_receive_bulk(): %" PRIkernel_pid ": No msg in queue. Going blocked.\n",
+              sched_active_thread->pid);
+        me->wait_data = (void *) buf;
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+        schedstat_trace(SCHEDSTAT_TRACE_MSG_RECEIVE, me->pid,
+                        KERNEL_PID_UNDEF);
+#endif
+        irq_restore(state);
+        thread_yield_higher();
+
+        /* sender copied the first message, pick up whatever was queued
+         * in the meantime */
+        n = 1;
+        if (max > 1) {
+            state = irq_disable();
+            n += _msg_drain(me, &buf[1], max - 1, &sender_prio);
+        }
+        else {
+            return n;
+        }
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
+unsigned msg_receive_bulk(msg_t *buf, unsigned max)
+{
+    return _msg_receive_bulk(buf, max, 1);
+}
+
+unsigned msg_try_receive_bulk(msg_t *buf, unsigned max)
+{
+    return _msg_receive_bulk(buf, max, 0);
+}
+
+int msg_try_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_try_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t*) sched_threads[target_pid];
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned n = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_try_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("msg_try_send_bulk: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", sender_pid, target_pid);
+        m[0].sender_pid = sender_pid;
+        *((msg_t*) target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        n++;
+    }
+
+    for (; n < num; n++) {
+        m[n].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[n])) {
+            break;
+        }
+    }
+
+    DEBUG("msg_try_send_bulk: %u of %u messages sent to %" PRIkernel_pid ".\n",
+          n, num, target_pid);
+
+    /* the target is either woken up directly or, if it waits for thread
+     * flags, by THREAD_FLAG_MSG_WAITING */
+    int target_runnable = (target->status >= STATUS_ON_RUNQUEUE);
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+    if ((n > 0) && target_runnable) {
+        sched_switch(target_prio);
+    }
+    return (int)n;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
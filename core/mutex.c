@@ -37,6 +37,78 @@
 
 #define MUTEX_LOCKED ((void*)-1)
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+static void _set_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->status == STATUS_MUTEX_BLOCKED) {
+        /* keep the wait queue of the mutex the thread is blocked on sorted */
+        mutex_t *mutex = thread->wait_data;
+        list_remove(&mutex->queue, (list_node_t*)&thread->rq_entry);
+        thread->priority = priority;
+        thread_add_to_list(&mutex->queue, thread);
+    }
+    else {
+        sched_change_priority(thread, priority);
+    }
+}
+
+static void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    list_add(&thread->held_mutexes, &mutex->owner_entry);
+}
+
+static void _release_owner(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t*)thread_get(mutex->owner);
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner == NULL) {
+        return;
+    }
+
+    list_remove(&owner->held_mutexes, &mutex->owner_entry);
+
+    /* fall back to the highest priority still lent by a waiter of any other
+     * mutex the owner holds */
+    uint8_t priority = owner->base_priority;
+    for (list_node_t *node = owner->held_mutexes.next; node; node = node->next) {
+        mutex_t *held = container_of(node, mutex_t, owner_entry);
+        if (held->queue.next != MUTEX_LOCKED) {
+            thread_t *waiter = container_of((clist_node_t*)held->queue.next,
+                                            thread_t, rq_entry);
+            if (waiter->priority < priority) {
+                priority = waiter->priority;
+            }
+        }
+    }
+
+    if (owner->priority != priority) {
+        DEBUG("PID[%" PRIkernel_pid "]: restoring priority %" PRIu32 "\n",
+              owner->pid, (uint32_t)priority);
+        _set_priority(owner, priority);
+    }
+}
+
+static void _inherit_priority(mutex_t *mutex, uint8_t priority)
+{
+    /* walk along the chain of owners as long as each of them is blocked on
+     * another mutex, this also terminates on deadlock cycles as every owner
+     * in the cycle already runs with the inherited priority after one round */
+    while (mutex) {
+        thread_t *owner = (thread_t*)thread_get(mutex->owner);
+        if ((owner == NULL) || (owner->priority <= priority)) {
+            return;
+        }
+
+        DEBUG("PID[%" PRIkernel_pid "]: inheriting priority %" PRIu32 "\n",
+              owner->pid, (uint32_t)priority);
+        mutex = (owner->status == STATUS_MUTEX_BLOCKED) ? owner->wait_data : NULL;
+        _set_priority(owner, priority);
+    }
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -46,6 +118,9 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _set_owner(mutex, (thread_t*)sched_active_thread);
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -63,6 +138,10 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        me->wait_data = mutex;
+        _inherit_priority(mutex, me->priority);
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -88,6 +167,10 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _release_owner(mutex);
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
@@ -102,6 +185,9 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    _set_owner(mutex, process);
+#endif
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -119,6 +205,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+        _release_owner(mutex);
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -128,6 +217,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+            _set_owner(mutex, process);
+#endif
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
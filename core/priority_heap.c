@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Pairing heap based priority queue
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "priority_heap.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* equal priorities are ordered by insertion, which makes the order total
+ * and therefore the heap stable */
+static inline int _before(const priority_heap_node_t *a,
+                          const priority_heap_node_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/* links two trees whose roots have no siblings, returns the new root */
+static priority_heap_node_t *_meld(priority_heap_node_t *a,
+                                   priority_heap_node_t *b)
+{
+    if (_before(b, a)) {
+        priority_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/* standard two-pass pairing of a list of siblings into one tree */
+static priority_heap_node_t *_merge_pairs(priority_heap_node_t *node)
+{
+    priority_heap_node_t *pairs = NULL;
+
+    /* first pass: meld pairs from left to right, collect the results in
+     * reverse order */
+    while (node) {
+        priority_heap_node_t *a = node;
+        priority_heap_node_t *b = node->next;
+
+        a->prev = NULL;
+        a->next = NULL;
+        if (b) {
+            node = b->next;
+            b->prev = NULL;
+            b->next = NULL;
+            a = _meld(a, b);
+        }
+        else {
+            node = NULL;
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: meld the pairs from right to left */
+    priority_heap_node_t *res = NULL;
+    while (pairs) {
+        priority_heap_node_t *next = pairs->next;
+        pairs->next = NULL;
+        res = (res) ? _meld(res, pairs) : pairs;
+        pairs = next;
+    }
+
+    return res;
+}
+
+void priority_heap_add(priority_heap_t *root, priority_heap_node_t *new_obj)
+{
+    /* not trying to add the same node twice */
+    assert(new_obj != root->first);
+
+    new_obj->child = NULL;
+    new_obj->next = NULL;
+    new_obj->prev = NULL;
+    new_obj->seq = root->seq++;
+
+    root->first = (root->first) ? _meld(root->first, new_obj) : new_obj;
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *root)
+{
+    priority_heap_node_t *head = root->first;
+
+    if (head) {
+        root->first = _merge_pairs(head->child);
+        head->child = NULL;
+    }
+
+    return head;
+}
+
+void priority_heap_remove(priority_heap_t *root, priority_heap_node_t *node)
+{
+    if (node == root->first) {
+        priority_heap_remove_head(root);
+        return;
+    }
+    if (node->prev == NULL) {
+        DEBUG("priority_heap_remove: node %p is not in a heap\n", (void *)node);
+        return;
+    }
+
+    /* cut the node's subtree out of the tree */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+    else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->prev = NULL;
+    node->next = NULL;
+
+    /* and put its children back */
+    priority_heap_node_t *sub = _merge_pairs(node->child);
+    node->child = NULL;
+    if (sub) {
+        root->first = _meld(root->first, sub);
+    }
+}
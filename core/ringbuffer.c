@@ -18,6 +18,7 @@
 
 #include "ringbuffer.h"
 
+#include <assert.h>
 #include <string.h>
 
 /**
@@ -54,14 +55,65 @@ static char get_head(ringbuffer_t *restrict rb)
 
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned free = rb->size - rb->avail;
+    if (n > free) {
+        n = free;
+    }
+    if (n > 0) {
+        unsigned pos = rb->start + rb->avail;
+        if (pos >= rb->size) {
+            pos -= rb->size;
+        }
+        unsigned bytes_till_end = rb->size - pos;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + pos, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + pos, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
+    }
+    return n;
+}
+
+unsigned ringbuffer_peek_span(ringbuffer_t *restrict rb, char **span)
+{
+    if (rb->avail == 0) {
+        /* make the whole buffer available in one span */
+        rb->start = 0;
+    }
+
+    unsigned pos = rb->start + rb->avail;
+    unsigned n;
+    if (pos >= rb->size) {
+        /* the used part wraps, the free part ends at start */
+        pos -= rb->size;
+        n = rb->start - pos;
     }
-    return i;
+    else {
+        n = rb->size - pos;
+    }
+
+    *span = rb->buf + pos;
+    return n;
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    assert(n <= ringbuffer_get_free(rb));
+    rb->avail += n;
+}
+
+unsigned ringbuffer_get_span(const ringbuffer_t *restrict rb, char **span)
+{
+    unsigned n = rb->size - rb->start;
+    if (n > rb->avail) {
+        n = rb->avail;
+    }
+
+    *span = rb->buf + rb->start;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -112,17 +164,16 @@ unsigned ringbuffer_get(ringbuffer_t *restrict rb, char *buf, unsigned n)
 
 unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
 {
-    if (n > rb->avail) {
+    if (n >= rb->avail) {
         n = rb->avail;
         rb->start = rb->avail = 0;
     }
     else {
-        rb->start -= n;
+        rb->start += n;
         rb->avail -= n;
 
-        /* compensate underflow */
-        if (rb->start > rb->size) {
-            rb->start += rb->size;
+        if (rb->start >= rb->size) {
+            rb->start -= rb->size;
         }
     }
 
@@ -58,8 +58,51 @@ clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
 static uint32_t runqueue_bitcache = 0;
 
 #ifdef MODULE_SCHEDSTATISTICS
+#ifndef SCHEDSTAT_NOW
+#define SCHEDSTAT_NOW()     xtimer_now()
+#endif
+
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
+uint32_t schedstat_window_start;
+uint32_t schedstat_last_window;
+
+uint32_t schedstat_now(void)
+{
+    return SCHEDSTAT_NOW();
+}
+
+static void _schedstat_roll_window(uint32_t time)
+{
+    if ((time - schedstat_window_start) < SCHEDSTAT_WINDOW) {
+        return;
+    }
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_pidlist[i].last_window_ticks = sched_pidlist[i].window_ticks;
+        sched_pidlist[i].window_ticks = 0;
+    }
+    schedstat_last_window = time - schedstat_window_start;
+    schedstat_window_start = time;
+}
+#endif
+
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+schedstat_trace_t schedstat_trace_ring[SCHEDSTAT_TRACE_SIZE];
+unsigned schedstat_trace_count;
+
+void schedstat_trace(uint8_t reason, kernel_pid_t from, kernel_pid_t to)
+{
+    unsigned state = irq_disable();
+    schedstat_trace_t *entry =
+        &schedstat_trace_ring[schedstat_trace_count++ & (SCHEDSTAT_TRACE_SIZE - 1)];
+
+    entry->time = SCHEDSTAT_NOW();
+    entry->from = from;
+    entry->to = to;
+    entry->reason = reason;
+    irq_restore(state);
+}
 #endif
 
 int __attribute__((used)) sched_run(void)
@@ -84,7 +127,7 @@ int __attribute__((used)) sched_run(void)
     }
 
 #ifdef MODULE_SCHEDSTATISTICS
-    unsigned long time = xtimer_now();
+    uint32_t time = SCHEDSTAT_NOW();
 #endif
 
     if (active_thread) {
@@ -102,11 +145,14 @@ int __attribute__((used)) sched_run(void)
         schedstat *active_stat = &sched_pidlist[active_thread->pid];
         if (active_stat->laststart) {
             active_stat->runtime_ticks += time - active_stat->laststart;
+            active_stat->window_ticks += time - active_stat->laststart;
         }
 #endif
     }
 
 #ifdef MODULE_SCHEDSTATISTICS
+    _schedstat_roll_window(time);
+
     schedstat *next_stat = &sched_pidlist[next_thread->pid];
     next_stat->laststart = time;
     next_stat->schedules++;
@@ -115,6 +161,12 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+    schedstat_trace(SCHEDSTAT_TRACE_SWITCH,
+                    active_thread ? active_thread->pid : KERNEL_PID_UNDEF,
+                    next_thread->pid);
+#endif
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
@@ -166,6 +218,33 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *process, uint8_t priority)
+{
+    if (process->priority == priority) {
+        return;
+    }
+
+    if (process->status >= STATUS_ON_RUNQUEUE) {
+        DEBUG("sched_change_priority: moving thread %" PRIkernel_pid " from runqueue %" PRIu16
+              " to runqueue %" PRIu16 ".\n", process->pid, process->priority, priority);
+        clist_remove(&sched_runqueues[process->priority], &(process->rq_entry));
+
+        if (!sched_runqueues[process->priority].next) {
+            runqueue_bitcache &= ~(1 << process->priority);
+        }
+
+        if (process == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &(process->rq_entry));
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &(process->rq_entry));
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    process->priority = priority;
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
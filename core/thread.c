@@ -225,6 +225,12 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
 
     cb->rq_entry.next = NULL;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    cb->wait_data = NULL;
+    cb->base_priority = priority;
+    cb->held_mutexes.next = NULL;
+#endif
+
 #ifdef MODULE_CORE_MSG
     cb->wait_data = NULL;
     cb->msg_waiters.next = NULL;
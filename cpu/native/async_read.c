@@ -22,6 +22,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
@@ -36,6 +39,21 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#if NATIVE_ASYNC_READ_EPOLL
+static int _epoll_fd = -1;
+
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+
+    /* only the descriptors that are actually readable are reported */
+    int n = epoll_wait(_epoll_fd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < n; i++) {
+        int index = events[i].data.u32;
+        _native_async_read_callbacks[index](_fds[index], _args[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,14 +79,28 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#if NATIVE_ASYNC_READ_EPOLL
+    if ((_epoll_fd == -1) &&
+        ((_epoll_fd = epoll_create1(EPOLL_CLOEXEC)) == -1)) {
+        err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
 void native_async_read_cleanup(void) {
     unregister_interrupt(SIGIO);
 
+#if NATIVE_ASYNC_READ_EPOLL
+    if (_epoll_fd != -1) {
+        real_close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
+
 #ifdef __MACH__
     for (int i = 0; i < _next_index; i++) {
         kill(_sigio_child_pids[i], SIGKILL);
@@ -96,6 +128,15 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     _args[_next_index] = arg;
     _native_async_read_callbacks[_next_index] = handler;
 
+#if NATIVE_ASYNC_READ_EPOLL
+    struct epoll_event event = { .events = EPOLLIN,
+                                 .data.u32 = _next_index };
+
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
+
 #ifdef __MACH__
     /* tuntap signalled IO is not working in OSX,
      * * check http://sourceforge.net/p/tuntaposx/bugs/17/ */
@@ -29,6 +29,22 @@ extern "C" {
 #define ASYNC_READ_NUMOF 2
 #endif
 
+/**
+ * @brief   Use epoll(7) to find the file descriptors that caused a SIGIO
+ *
+ * When enabled, all monitored file descriptors are kept in one epoll
+ * instance and the SIGIO handler only gets the ready ones handed back by
+ * the kernel, instead of building an fd_set and testing every descriptor
+ * with select(2). Defaults to 1 on Linux, set to 0 to use select(2).
+ */
+#ifndef NATIVE_ASYNC_READ_EPOLL
+#ifdef __linux__
+#define NATIVE_ASYNC_READ_EPOLL 1
+#else
+#define NATIVE_ASYNC_READ_EPOLL 0
+#endif
+#endif
+
 /**
  * @brief   asynchronus read callback type
  */
@@ -37,7 +53,7 @@ typedef void (*native_async_read_callback_t)(int fd, void *arg);
 /**
  * @brief   initialize asynchronus read system
  *
- * This registers SIGIO signal handler.
+ * This registers SIGIO signal handler. Can be called more than once.
  */
 void native_async_read_setup(void);
 
@@ -50,6 +50,7 @@
 #include <sys/uio.h>
 
 #include "kernel_types.h"
+#include "native_switch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -125,6 +126,7 @@ extern const char* (*real_gai_strerror)(int errcode);
 extern FILE* (*real_fopen)(const char *path, const char *mode);
 extern mode_t (*real_umask)(mode_t cmask);
 extern ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+extern ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
@@ -147,6 +149,11 @@ extern ucontext_t native_isr_context;
 extern ucontext_t end_context;
 extern ucontext_t *_native_cur_ctx, *_native_isr_ctx;
 
+/**
+ * @brief   Signal mask with all interrupts blocked
+ */
+extern sigset_t _native_sig_set_dint;
+
 extern const char *_progname;
 extern char **_native_argv;
 extern pid_t _native_pid;
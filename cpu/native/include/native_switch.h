@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Context switching primitives of the native port
+ *
+ * By default native switches contexts with swapcontext(3) and
+ * setcontext(3). With glibc each of these calls issues an rt_sigprocmask
+ * system call, so a thread_yield_higher() costs several system calls.
+ *
+ * The (pseudo) module `native_asm_switch` replaces them with a switch that
+ * only saves and restores the callee-saved registers, stack and program
+ * counter (Linux/i386 only, elsewhere it has no effect). Signals are then
+ * only blocked and unblocked by irq_disable() and irq_enable().
+ *
+ * This header is included from assembly, too. C code gets it through
+ * native_internal.h, which includes ucontext.h the way the host needs it.
+ */
+
+#ifndef NATIVE_SWITCH_H
+#define NATIVE_SWITCH_H
+
+#if defined(MODULE_NATIVE_ASM_SWITCH) && defined(__i386__) && defined(__linux__)
+/**
+ * @brief   Defined if the register-only context switch is used
+ */
+#define NATIVE_ASM_SWITCH       (1)
+
+/**
+ * @name    Offsets of uc_mcontext.gregs[REG_*] in glibc's i386 ucontext_t
+ *
+ * Checked against the system headers by native_cpu_init().
+ * @{
+ */
+#define NATIVE_CTX_EDI          (36)
+#define NATIVE_CTX_ESI          (40)
+#define NATIVE_CTX_EBP          (44)
+#define NATIVE_CTX_ESP          (48)
+#define NATIVE_CTX_EBX          (52)
+#define NATIVE_CTX_EIP          (76)
+/** @} */
+
+/**
+ * @brief   Bytes needed to save the FPU state around an interrupt
+ *
+ * The 108 bytes written by fnsave, followed by MXCSR if the code uses SSE.
+ */
+#define NATIVE_FPU_CTX_SIZE     (112)
+
+/**
+ * @brief   Offset of MXCSR in the saved FPU state
+ */
+#define NATIVE_FPU_CTX_MXCSR    (108)
+#endif
+
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef NATIVE_ASM_SWITCH
+/**
+ * @brief   Save the current context to @p from and switch to @p to
+ *
+ * Register-only replacement for swapcontext(3). The signal mask is left
+ * untouched.
+ *
+ * @return  0 when @p from is resumed
+ */
+int _native_ctx_swap(ucontext_t *from, const ucontext_t *to);
+
+/**
+ * @brief   Switch to @p to
+ *
+ * Register-only replacement for setcontext(3). The signal mask is left
+ * untouched.
+ *
+ * @return  does not return
+ */
+int _native_ctx_set(const ucontext_t *to);
+
+/**
+ * @brief   Save the FPU state of the interrupted thread
+ *
+ * The register-only switch does not save the FPU environment like
+ * swapcontext(3) does, so it is saved around interrupts, which may run at
+ * any point of a thread. The FPU is reinitialized for the handler.
+ *
+ * @param[out] buf  @ref NATIVE_FPU_CTX_SIZE bytes
+ */
+static inline void _native_fpu_save(uint8_t *buf)
+{
+    __asm__ volatile ("fnsave (%0)" : : "r" (buf) : "memory");
+#ifdef __SSE__
+    __asm__ volatile ("stmxcsr (%0)" : : "r" (buf + NATIVE_FPU_CTX_MXCSR) : "memory");
+#endif
+}
+
+/**
+ * @brief   Restore the FPU state saved by _native_fpu_save()
+ *
+ * @param[in] buf   The saved state
+ */
+static inline void _native_fpu_restore(const uint8_t *buf)
+{
+#ifdef __SSE__
+    __asm__ volatile ("ldmxcsr (%0)" : : "r" (buf + NATIVE_FPU_CTX_MXCSR) : "memory");
+#endif
+    __asm__ volatile ("frstor (%0)" : : "r" (buf) : "memory");
+}
+
+#define _native_swapcontext(from, to)   _native_ctx_swap(from, to)
+#define _native_setcontext(to)          _native_ctx_set(to)
+#else
+#define _native_swapcontext(from, to)   swapcontext(from, to)
+#define _native_setcontext(to)          setcontext(to)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __ASSEMBLER__ */
+
+#endif /* NATIVE_SWITCH_H */
+/** @} */
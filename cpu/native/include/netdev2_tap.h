@@ -35,6 +35,34 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames handled per interrupt
+ *
+ * After a frame was received, the driver checks for further frames waiting
+ * at the tap interface and hands up to this many frames to the upper layer
+ * before returning from its ISR.
+ */
+#ifndef NETDEV2_TAP_RX_BATCH
+#define NETDEV2_TAP_RX_BATCH    (8U)
+#endif
+
+/**
+ * @brief   Exchange checksum offload information with the host
+ *
+ * If enabled, every frame is preceded by a virtio net header, so the host
+ * completes the UDP and ICMPv6 checksums of sent frames and tells which
+ * checksums of received frames it already verified (see
+ * @ref NETOPT_CSUM_OFFLOAD_TX and @ref NETOPT_CSUM_OFFLOAD_RX).
+ * Only supported on Linux.
+ */
+#ifndef NETDEV2_TAP_CSUM_OFFLOAD
+#ifdef __linux__
+#define NETDEV2_TAP_CSUM_OFFLOAD    (1)
+#else
+#define NETDEV2_TAP_CSUM_OFFLOAD    (0)
+#endif
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +72,8 @@ typedef struct netdev2_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint8_t vnet_hdr;                   /**< Frames are preceded by a virtio
+                                             net header */
 } netdev2_tap_t;
 
 /**
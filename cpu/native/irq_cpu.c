@@ -49,7 +49,8 @@ volatile int native_interrupts_enabled = 0;
 volatile int _native_in_isr;
 volatile int _native_in_syscall;
 
-static sigset_t _native_sig_set, _native_sig_set_dint;
+static sigset_t _native_sig_set;
+sigset_t _native_sig_set_dint;
 
 char __isr_stack[SIGSTKSZ];
 ucontext_t native_isr_context;
@@ -260,6 +261,9 @@ void native_irq_handler(void)
         int sig = _native_popsig();
         _native_sigpend--;
 
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+        schedstat_trace(SCHEDSTAT_TRACE_IRQ, sched_active_pid, sig);
+#endif
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
             native_irq_handlers[sig]();
@@ -22,6 +22,7 @@
  */
 
 #include <stdio.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <stdlib.h>
 
@@ -103,6 +104,18 @@ int thread_arch_isr_stack_usage(void)
     return -1;
 }
 
+#ifdef NATIVE_ASM_SWITCH
+/**
+ * setcontext(3) used to unblock signals for a new thread by restoring its
+ * empty signal mask, _native_ctx_set() leaves them blocked
+ */
+static void _native_thread_start(thread_task_func_t task_func, void *arg)
+{
+    irq_enable();
+    task_func(arg);
+}
+#endif
+
 char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_start, int stacksize)
 {
     char *stk;
@@ -132,7 +145,11 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
         err(EXIT_FAILURE, "thread_stack_init: sigemptyset");
     }
 
+#ifdef NATIVE_ASM_SWITCH
+    makecontext(p, (void (*)(void)) _native_thread_start, 2, task_func, arg);
+#else
     makecontext(p, (void (*)(void)) task_func, 1, arg);
+#endif
 
     return (char *) p;
 }
@@ -152,7 +169,7 @@ void isr_cpu_switch_context_exit(void)
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
 
-    if (setcontext(ctx) == -1) {
+    if (_native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_cpu_switch_context_exit: setcontext");
     }
     errx(EXIT_FAILURE, "2 this should have never been reached!!");
@@ -174,7 +191,7 @@ void cpu_switch_context_exit(void)
         native_isr_context.uc_stack.ss_size = sizeof(__isr_stack);
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_cpu_switch_context_exit, 0);
-        if (setcontext(&native_isr_context) == -1) {
+        if (_native_setcontext(&native_isr_context) == -1) {
             err(EXIT_FAILURE, "cpu_switch_context_exit: setcontext");
         }
         errx(EXIT_FAILURE, "1 this should have never been reached!!");
@@ -201,7 +218,7 @@ void isr_thread_yield(void)
     native_interrupts_enabled = 1;
     _native_mod_ctx_leave_sigh(ctx);
 
-    if (setcontext(ctx) == -1) {
+    if (_native_setcontext(ctx) == -1) {
         err(EXIT_FAILURE, "isr_thread_yield: setcontext");
     }
 }
@@ -219,7 +236,7 @@ void thread_yield_higher(void)
         native_isr_context.uc_stack.ss_size = SIGSTKSZ;
         native_isr_context.uc_stack.ss_flags = 0;
         makecontext(&native_isr_context, isr_thread_yield, 0);
-        if (swapcontext(ctx, &native_isr_context) == -1) {
+        if (_native_swapcontext(ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "thread_yield_higher: swapcontext");
         }
         irq_enable();
@@ -231,6 +248,18 @@ void thread_yield_higher(void)
 
 void native_cpu_init(void)
 {
+#ifdef NATIVE_ASM_SWITCH
+    if ((offsetof(ucontext_t, uc_mcontext.gregs[REG_EDI]) != NATIVE_CTX_EDI) ||
+        (offsetof(ucontext_t, uc_mcontext.gregs[REG_ESI]) != NATIVE_CTX_ESI) ||
+        (offsetof(ucontext_t, uc_mcontext.gregs[REG_EBP]) != NATIVE_CTX_EBP) ||
+        (offsetof(ucontext_t, uc_mcontext.gregs[REG_ESP]) != NATIVE_CTX_ESP) ||
+        (offsetof(ucontext_t, uc_mcontext.gregs[REG_EBX]) != NATIVE_CTX_EBX) ||
+        (offsetof(ucontext_t, uc_mcontext.gregs[REG_EIP]) != NATIVE_CTX_EIP)) {
+        errx(EXIT_FAILURE, "native_cpu_init: unexpected ucontext_t layout, "
+             "build without native_asm_switch");
+    }
+#endif
+
     if (getcontext(&end_context) == -1) {
         err(EXIT_FAILURE, "native_cpu_init: getcontext");
     }
@@ -21,6 +21,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -57,6 +58,17 @@
 #include "net/netopt.h"
 #include "net/eui64.h"
 
+#if NETDEV2_TAP_CSUM_OFFLOAD
+#include <linux/virtio_net.h>
+
+#include "net/ethertype.h"
+#include "net/icmpv6.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -67,6 +79,8 @@ netdev2_tap_t netdev2_tap;
 static int _init(netdev2_t *netdev);
 static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned n);
 static int _recv(netdev2_t *netdev, void *buf, size_t n, void *info);
+static bool _rx_pending(netdev2_tap_t *dev);
+static void _continue_reading(netdev2_tap_t *dev);
 
 static inline void _get_mac_addr(netdev2_t *netdev, uint8_t *dst)
 {
@@ -96,7 +110,16 @@ static inline int _set_promiscous(netdev2_t *netdev, int value)
 static inline void _isr(netdev2_t *netdev)
 {
     if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        netdev2_tap_t *dev = (netdev2_tap_t*)netdev;
+        unsigned n = 0;
+
+        /* handle frames that queued up in the meantime without another
+         * round trip through the signal handler */
+        do {
+            netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        } while ((++n < NETDEV2_TAP_RX_BATCH) && _rx_pending(dev));
+
+        _continue_reading(dev);
     }
 #if DEVELHELP
     else {
@@ -127,6 +150,17 @@ static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+        case NETOPT_CSUM_OFFLOAD_TX:
+        case NETOPT_CSUM_OFFLOAD_RX:
+            if (max_len < sizeof(netopt_enable_t)) {
+                res = -EOVERFLOW;
+            }
+            else {
+                *((netopt_enable_t *)value) = (((netdev2_tap_t *)dev)->vnet_hdr) ?
+                                              NETOPT_ENABLE : NETOPT_DISABLE;
+                res = sizeof(netopt_enable_t);
+            }
+            break;
         default:
             res = netdev2_eth_get(dev, opt, value, max_len);
             break;
@@ -182,18 +216,27 @@ static inline bool _is_addr_multicast(uint8_t *addr)
     return (addr[0] & 0x01);
 }
 
-static void _continue_reading(netdev2_tap_t *dev)
+static bool _rx_pending(netdev2_tap_t *dev)
 {
-    /* work around lost signals */
     fd_set rfds;
     struct timeval t;
     memset(&t, 0, sizeof(t));
     FD_ZERO(&rfds);
     FD_SET(dev->tap_fd, &rfds);
 
+    _native_in_syscall++; /* no switching here */
+    int res = real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t);
+    _native_in_syscall--;
+
+    return (res == 1);
+}
+
+static void _continue_reading(netdev2_tap_t *dev)
+{
+    /* work around lost signals */
     _native_in_syscall++; /* no switching here */
 
-    if (real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t) == 1) {
+    if (_rx_pending(dev)) {
         int sig = SIGIO;
         extern int _sig_pipefd[2];
         extern ssize_t (*real_write)(int fd, const void * buf, size_t count);
@@ -209,10 +252,148 @@ static void _continue_reading(netdev2_tap_t *dev)
     _native_in_syscall--;
 }
 
+#if NETDEV2_TAP_CSUM_OFFLOAD
+/* offset of the upper layer header in frames the host completes the checksum
+ * of */
+#define CSUM_START  (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t))
+
+/* returns the offset of the checksum field in the upper layer header if the
+ * frame carries UDP or ICMPv6 directly over IPv6, 0 otherwise */
+static size_t _csum_offset(const uint8_t *frame, size_t len)
+{
+    if ((len < CSUM_START) ||
+        (((frame[12] << 8) | frame[13]) != ETHERTYPE_IPV6)) {
+        return 0;
+    }
+    switch (frame[sizeof(ethernet_hdr_t) + offsetof(ipv6_hdr_t, nh)]) {
+        case PROTNUM_UDP:
+            return (len >= (CSUM_START + sizeof(udp_hdr_t))) ?
+                   offsetof(udp_hdr_t, checksum) : 0;
+        case PROTNUM_ICMPV6:
+            return (len >= (CSUM_START + sizeof(icmpv6_hdr_t))) ?
+                   offsetof(icmpv6_hdr_t, csum) : 0;
+        default:
+            return 0;
+    }
+}
+
+/* completes the checksum the host left to us and marks checksums the host
+ * verified */
+static void _csum_rx(uint8_t *frame, size_t len, const struct virtio_net_hdr *vnet,
+                     netdev2_eth_rx_info_t *info)
+{
+    bool valid = (vnet->flags & VIRTIO_NET_HDR_F_DATA_VALID);
+
+    if (vnet->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+        size_t pos = vnet->csum_start + vnet->csum_offset;
+        uint16_t csum;
+
+        if ((vnet->csum_start >= len) || ((pos + sizeof(uint16_t)) > len)) {
+            DEBUG("netdev2_tap: invalid checksum offset\n");
+            return;
+        }
+        /* the checksum field holds the sum of the pseudo header */
+        csum = ~inet_csum(0, frame + vnet->csum_start, len - vnet->csum_start);
+        if (csum == 0) {
+            csum = 0xffff;
+        }
+        frame[pos] = csum >> 8;
+        frame[pos + 1] = csum & 0xff;
+        valid = true;
+    }
+    if (valid && (info != NULL) && (_csum_offset(frame, len) != 0)) {
+        info->flags |= NETDEV2_ETH_RX_CSUM_VALID;
+    }
+}
+
+/* copies the first bytes of a frame, returns the number of bytes copied */
+static size_t _gather(uint8_t *dst, size_t len, const struct iovec *vector,
+                      unsigned n)
+{
+    size_t copied = 0;
+
+    for (unsigned i = 0; (i < n) && (copied < len); i++) {
+        size_t part = len - copied;
+
+        if (part > vector[i].iov_len) {
+            part = vector[i].iov_len;
+        }
+        memcpy(dst + copied, vector[i].iov_base, part);
+        copied += part;
+    }
+
+    return copied;
+}
+
+/* sends a frame behind a virtio net header. The host is only asked to
+ * complete the UDP or ICMPv6 checksum if the stack left it zero, all other
+ * frames (e.g. forwarded ones) go out as they are */
+static int _writev_vnet(netdev2_tap_t *dev, const struct iovec *vector,
+                        unsigned n)
+{
+    /* room for the header and for the checksum field splitting a vector */
+    struct iovec vec[n + 3];
+    struct virtio_net_hdr vnet;
+    uint8_t hdrs[CSUM_START + sizeof(udp_hdr_t)];
+    network_uint16_t csum;
+    size_t pos = _csum_offset(hdrs, _gather(hdrs, sizeof(hdrs), vector, n));
+    unsigned vec_n = 0;
+    int res;
+
+    if ((pos != 0) && ((hdrs[CSUM_START + pos] != 0) ||
+                       (hdrs[CSUM_START + pos + 1] != 0))) {
+        pos = 0;
+    }
+    memset(&vnet, 0, sizeof(vnet));
+    vec[vec_n].iov_base = &vnet;
+    vec[vec_n++].iov_len = sizeof(vnet);
+    if (pos == 0) {
+        memcpy(&vec[vec_n], vector, n * sizeof(struct iovec));
+        vec_n += n;
+    }
+    else {
+        ipv6_hdr_t ipv6;
+        size_t start = 0;
+
+        memcpy(&ipv6, &hdrs[sizeof(ethernet_hdr_t)], sizeof(ipv6));
+        vnet.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+        vnet.csum_start = CSUM_START;
+        vnet.csum_offset = pos;
+        /* the host adds the upper layer to the sum of the pseudo header in
+         * the checksum field */
+        csum = byteorder_htons(ipv6_hdr_inet_csum(0, &ipv6, ipv6.nh,
+                                                  byteorder_ntohs(ipv6.len)));
+        pos += CSUM_START;
+        for (unsigned i = 0; i < n; i++) {
+            uint8_t *base = vector[i].iov_base;
+            size_t end = start + vector[i].iov_len;
+
+            if (start < pos) {
+                vec[vec_n].iov_base = base;
+                vec[vec_n++].iov_len = ((end < pos) ? end : pos) - start;
+            }
+            if ((start <= pos) && (pos < end)) {
+                vec[vec_n].iov_base = &csum;
+                vec[vec_n++].iov_len = sizeof(csum);
+            }
+            if (end > (pos + sizeof(csum))) {
+                size_t from = (start > (pos + sizeof(csum))) ? start : (pos + sizeof(csum));
+
+                vec[vec_n].iov_base = base + (from - start);
+                vec[vec_n++].iov_len = end - from;
+            }
+            start = end;
+        }
+    }
+
+    res = _native_writev(dev->tap_fd, vec, vec_n);
+    return (res > 0) ? (res - (int)sizeof(vnet)) : res;
+}
+#endif
+
 static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
 {
     netdev2_tap_t *dev = (netdev2_tap_t*)netdev2;
-    (void)info;
 
     if (!buf) {
         int waiting_bytes;
@@ -232,8 +413,6 @@ static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
             static uint8_t buf[ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, buf, sizeof(buf));
-
-            _continue_reading(dev);
         }
 
         /* get number of waiting bytes at dev->tap_fd */
@@ -241,7 +420,26 @@ static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
         return waiting_bytes;
     }
 
+#if NETDEV2_TAP_CSUM_OFFLOAD
+    struct virtio_net_hdr vnet;
+    int nread;
+
+    if (dev->vnet_hdr) {
+        struct iovec vec[] = { { .iov_base = &vnet, .iov_len = sizeof(vnet) },
+                               { .iov_base = buf, .iov_len = len } };
+
+        nread = real_readv(dev->tap_fd, vec, 2);
+        if (nread > 0) {
+            nread = (nread > (int)sizeof(vnet)) ? (nread - (int)sizeof(vnet)) : 0;
+        }
+    }
+    else {
+        nread = real_read(dev->tap_fd, buf, len);
+    }
+#else
+    (void)info;
     int nread = real_read(dev->tap_fd, buf, len);
+#endif
     DEBUG("netdev2_tap: read %d bytes\n", nread);
 
     if (nread > 0) {
@@ -259,8 +457,11 @@ static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
             return 0;
         }
 
-        _continue_reading(dev);
-
+#if NETDEV2_TAP_CSUM_OFFLOAD
+        if (dev->vnet_hdr) {
+            _csum_rx(buf, nread, &vnet, info);
+        }
+#endif
 #ifdef MODULE_NETSTATS_L2
         netdev2->stats.rx_count++;
         netdev2->stats.rx_bytes += nread;
@@ -287,7 +488,12 @@ static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
 static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned n)
 {
     netdev2_tap_t *dev = (netdev2_tap_t*)netdev;
+#if NETDEV2_TAP_CSUM_OFFLOAD
+    int res = (dev->vnet_hdr) ? _writev_vnet(dev, vector, n) :
+                                _native_writev(dev->tap_fd, vector, n);
+#else
     int res = _native_writev(dev->tap_fd, vector, n);
+#endif
 #ifdef MODULE_NETSTATS_L2
     size_t bytes = 0;
     for (unsigned i = 0; i < n; i++) {
@@ -345,6 +551,7 @@ static int _init(netdev2_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->vnet_hdr = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
@@ -365,7 +572,20 @@ static int _init(netdev2_t *netdev)
     memset(&ifr, 0, sizeof(ifr));
     ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
     strncpy(ifr.ifr_name, name, IFNAMSIZ);
-    if (real_ioctl(dev->tap_fd, TUNSETIFF, (void *)&ifr) == -1) {
+#if NETDEV2_TAP_CSUM_OFFLOAD
+    ifr.ifr_flags |= IFF_VNET_HDR;
+    if (real_ioctl(dev->tap_fd, TUNSETIFF, (void *)&ifr) == 0) {
+        dev->vnet_hdr = 1;
+        /* we complete partial checksums of received frames, so the host
+         * does not need to */
+        if (real_ioctl(dev->tap_fd, TUNSETOFFLOAD, TUN_F_CSUM) == -1) {
+            DEBUG("netdev2_tap: host always completes checksums\n");
+        }
+    }
+    /* otherwise fall back to frames without header */
+    ifr.ifr_flags &= ~IFF_VNET_HDR;
+#endif
+    if (!dev->vnet_hdr && (real_ioctl(dev->tap_fd, TUNSETIFF, (void *)&ifr) == -1)) {
         _native_in_syscall++;
         warn("ioctl TUNSETIFF");
         warnx("probably the tap interface (%s) does not exist or is already in use", name);
@@ -14,10 +14,12 @@
  * @file
  * @brief Native CPU periph/timer.h implementation
  *
- * Uses POSIX realtime clock and POSIX itimer to mimic hardware.
+ * Uses the host's monotonic clock to mimic hardware. The channels are
+ * multiplexed onto one host timer that is armed for the earliest deadline.
+ * On Linux this is a POSIX timer on CLOCK_MONOTONIC, armed with the absolute
+ * deadline and delivering its own signal, elsewhere the POSIX itimer.
  *
  * This is based on native's hwtimer implementation by Ludwig Knüpfer.
- * I removed the multiplexing, as xtimer does the same. (kaspar)
  *
  * @}
  */
@@ -49,32 +51,153 @@
 
 #define NATIVE_TIMER_SPEED 1000000
 
-static unsigned long time_null;
+/**
+ * signal used by the host timer
+ */
+#ifdef __linux__
+#define NATIVE_TIMER_SIGNAL (SIGRTMIN)
+#else
+#define NATIVE_TIMER_SIGNAL (SIGALRM)
+#endif
+
+static uint64_t time_null;
 
 static timer_cb_t _callback;
 static void *_cb_arg;
 
+/**
+ * absolute deadlines of the channels, in ticks since time_null
+ */
+static uint64_t _deadline[TIMER_CHANNELS];
+static unsigned _armed;
+static int _in_isr;
+
+#ifdef __linux__
+static timer_t _host_timer;
+static int _host_timer_created;
+#else
 static struct itimerval itv;
+#endif
 
 /**
  * returns ticks for give timespec
  */
-static unsigned long ts2ticks(struct timespec *tp)
+static uint64_t ts2ticks(struct timespec *tp)
 {
-    /* TODO: check for overflow */
-    return((tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
+    return (((uint64_t)tp->tv_sec * NATIVE_TIMER_SPEED) + (tp->tv_nsec / 1000));
+}
+
+static void _host_now(struct timespec *t)
+{
+    _native_syscall_enter();
+#ifdef __MACH__
+    clock_serv_t cclock;
+    mach_timespec_t mts;
+    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
+    clock_get_time(cclock, &mts);
+    mach_port_deallocate(mach_task_self(), cclock);
+    t->tv_sec = mts.tv_sec;
+    t->tv_nsec = mts.tv_nsec;
+#else
+
+    if (real_clock_gettime(CLOCK_MONOTONIC, t) == -1) {
+        err(EXIT_FAILURE, "timer_read: clock_gettime");
+    }
+
+#endif
+    _native_syscall_leave();
+}
+
+/**
+ * returns the current time in ticks since time_null, without wrapping
+ */
+static uint64_t _now64(void)
+{
+    struct timespec t;
+
+    _host_now(&t);
+
+    return ts2ticks(&t) - time_null;
+}
+
+/**
+ * arm the host timer for the earliest pending deadline
+ */
+static void _arm(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned i = 0; i < TIMER_CHANNELS; i++) {
+        if ((_armed & (1 << i)) && (_deadline[i] < next)) {
+            next = _deadline[i];
+        }
+    }
+
+#ifdef __linux__
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    if (_armed) {
+        /* an absolute deadline in the past expires immediately */
+        next += time_null;
+        its.it_value.tv_sec = next / NATIVE_TIMER_SPEED;
+        its.it_value.tv_nsec = (next % NATIVE_TIMER_SPEED) * 1000;
+    }
+
+    DEBUG("_arm(): setting %u.%09u\n", (unsigned)its.it_value.tv_sec,
+          (unsigned)its.it_value.tv_nsec);
+
+    _native_syscall_enter();
+    if (timer_settime(_host_timer, TIMER_ABSTIME, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+    _native_syscall_leave();
+#else
+    unsigned int offset = 0;
+
+    if (_armed) {
+        uint64_t now = _now64();
+        offset = (next > now) ? (next - now) : 0;
+        if (offset < NATIVE_TIMER_MIN_RES) {
+            offset = NATIVE_TIMER_MIN_RES;
+        }
+    }
+
+    memset(&itv, 0, sizeof(itv));
+    itv.it_value.tv_sec = (offset / 1000000);
+    itv.it_value.tv_usec = offset % 1000000;
+
+    DEBUG("_arm(): setting %u.%06u\n", (unsigned)itv.it_value.tv_sec, (unsigned)itv.it_value.tv_usec);
+
+    _native_syscall_enter();
+    if (real_setitimer(ITIMER_REAL, &itv, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: setitimer");
+    }
+    _native_syscall_leave();
+#endif
 }
 
 /**
  * native timer signal handler
  *
- * set new system timer, call timer interrupt handler
+ * call the callbacks of all expired channels, set new system timer
  */
 void native_isr_timer(void)
 {
     DEBUG("%s\n", __func__);
 
-    _callback(_cb_arg, 0);
+    uint64_t now = _now64();
+
+    _in_isr = 1;
+    for (unsigned i = 0; i < TIMER_CHANNELS; i++) {
+        if ((_armed & (1 << i)) && (_deadline[i] <= now)) {
+            _armed &= ~(1 << i);
+            _callback(_cb_arg, i);
+        }
+    }
+    _in_isr = 0;
+
+    _arm();
 }
 
 int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
@@ -88,9 +211,27 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
         return -1;
     }
 
+#ifdef __linux__
+    if (!_host_timer_created) {
+        struct sigevent sev;
+
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = NATIVE_TIMER_SIGNAL;
+
+        _native_syscall_enter();
+        if (timer_create(CLOCK_MONOTONIC, &sev, &_host_timer) == -1) {
+            err(EXIT_FAILURE, "timer_init: timer_create");
+        }
+        _native_syscall_leave();
+        _host_timer_created = 1;
+    }
+#endif
+
     /* initialize time delta */
     time_null = 0;
-    time_null = timer_read(0);
+    time_null = _now64();
+    _armed = 0;
 
     timer_irq_disable(dev);
     _callback = cb;
@@ -100,25 +241,27 @@ int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
     return 0;
 }
 
-static void do_timer_set(unsigned int offset)
+int timer_set_absolute(tim_t dev, int channel, unsigned int value)
 {
+    (void)dev;
     DEBUG("%s\n", __func__);
 
-    if (offset && offset < NATIVE_TIMER_MIN_RES) {
-        offset = NATIVE_TIMER_MIN_RES;
+    if ((channel < 0) || ((unsigned)channel >= TIMER_CHANNELS)) {
+        return -1;
     }
 
-    memset(&itv, 0, sizeof(itv));
-    itv.it_value.tv_sec = (offset / 1000000);
-    itv.it_value.tv_usec = offset % 1000000;
+    uint64_t now = _now64();
 
-    DEBUG("timer_set(): setting %u.%06u\n", (unsigned)itv.it_value.tv_sec, (unsigned)itv.it_value.tv_usec);
+    /* like a compare register: the deadline is the next time the 32 bit
+     * counter reaches value, which may be up to a full period ahead */
+    _deadline[channel] = now + (uint32_t)(value - (uint32_t)now);
+    _armed |= (1 << channel);
 
-    _native_syscall_enter();
-    if (real_setitimer(ITIMER_REAL, &itv, NULL) == -1) {
-        err(EXIT_FAILURE, "timer_arm: setitimer");
+    if (!_in_isr) {
+        _arm();
     }
-    _native_syscall_leave();
+
+    return 1;
 }
 
 int timer_set(tim_t dev, int channel, unsigned int offset)
@@ -126,31 +269,33 @@ int timer_set(tim_t dev, int channel, unsigned int offset)
     (void)dev;
     DEBUG("%s\n", __func__);
 
-    if (channel != 0) {
+    if ((channel < 0) || ((unsigned)channel >= TIMER_CHANNELS)) {
         return -1;
     }
 
-    if (!offset) {
-        offset = NATIVE_TIMER_MIN_RES;
-    }
+    _deadline[channel] = _now64() + offset;
+    _armed |= (1 << channel);
 
-    do_timer_set(offset);
+    if (!_in_isr) {
+        _arm();
+    }
 
     return 1;
 }
 
-int timer_set_absolute(tim_t dev, int channel, unsigned int value)
-{
-    uint32_t now = timer_read(dev);
-    return timer_set(dev, channel, value - now);
-}
-
 int timer_clear(tim_t dev, int channel)
 {
     (void)dev;
-    (void)channel;
 
-    do_timer_set(0);
+    if ((channel < 0) || ((unsigned)channel >= TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    _armed &= ~(1 << channel);
+
+    if (!_in_isr) {
+        _arm();
+    }
 
     return 1;
 }
@@ -160,7 +305,7 @@ void timer_irq_enable(tim_t dev)
     (void)dev;
     DEBUG("%s\n", __func__);
 
-    if (register_interrupt(SIGALRM, native_isr_timer) != 0) {
+    if (register_interrupt(NATIVE_TIMER_SIGNAL, native_isr_timer) != 0) {
         DEBUG("darn!\n\n");
     }
 
@@ -172,7 +317,7 @@ void timer_irq_disable(tim_t dev)
     (void)dev;
     DEBUG("%s\n", __func__);
 
-    if (unregister_interrupt(SIGALRM) != 0) {
+    if (unregister_interrupt(NATIVE_TIMER_SIGNAL) != 0) {
         DEBUG("darn!\n\n");
     }
 
@@ -197,27 +342,7 @@ unsigned int timer_read(tim_t dev)
         return 0;
     }
 
-    struct timespec t;
-
     DEBUG("timer_read()\n");
 
-    _native_syscall_enter();
-#ifdef __MACH__
-    clock_serv_t cclock;
-    mach_timespec_t mts;
-    host_get_clock_service(mach_host_self(), SYSTEM_CLOCK, &cclock);
-    clock_get_time(cclock, &mts);
-    mach_port_deallocate(mach_task_self(), cclock);
-    t.tv_sec = mts.tv_sec;
-    t.tv_nsec = mts.tv_nsec;
-#else
-
-    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
-        err(EXIT_FAILURE, "timer_read: clock_gettime");
-    }
-
-#endif
-    _native_syscall_leave();
-
-    return ts2ticks(&t) - time_null;
+    return (unsigned int)_now64();
 }
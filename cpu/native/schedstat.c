@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Dump of the scheduler trace ring to a host file
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <fcntl.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "native_internal.h"
+
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+
+#define DUMP_VERSION    (1U)
+
+static int _write(int fd, const void *buf, size_t len)
+{
+    _native_syscall_enter();
+    ssize_t res = real_write(fd, buf, len);
+    _native_syscall_leave();
+
+    return (res == (ssize_t)len) ? 0 : -1;
+}
+
+int schedstat_trace_dump(const char *path)
+{
+    int res = 0;
+
+    _native_syscall_enter();
+    int fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _native_syscall_leave();
+    if (fd == -1) {
+        return -1;
+    }
+
+    /* keep the scheduler from adding entries while we write */
+    unsigned state = irq_disable();
+
+    unsigned count = schedstat_trace_count;
+    unsigned first = 0;
+    if (count > SCHEDSTAT_TRACE_SIZE) {
+        first = count - SCHEDSTAT_TRACE_SIZE;
+    }
+
+    const char magic[8] = { 'R', 'I', 'O', 'T', 'T', 'R', 'C', DUMP_VERSION };
+    uint32_t hdr[] = { SCHEDSTAT_HZ, count - first, sizeof(schedstat_trace_t) };
+
+    if ((_write(fd, magic, sizeof(magic)) < 0) ||
+        (_write(fd, hdr, sizeof(hdr)) < 0)) {
+        res = -1;
+    }
+    for (unsigned i = first; (res == 0) && (i < count); i++) {
+        if (_write(fd, &schedstat_trace_ring[i & (SCHEDSTAT_TRACE_SIZE - 1)],
+                   sizeof(schedstat_trace_t)) < 0) {
+            res = -1;
+        }
+    }
+
+    irq_restore(state);
+
+    _native_syscall_enter();
+    real_close(fd);
+    _native_syscall_leave();
+
+    return (res == 0) ? (int)(count - first) : -1;
+}
+
+#endif /* MODULE_SCHEDSTATISTICS_TRACE */
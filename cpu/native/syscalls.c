@@ -91,6 +91,7 @@ const char* (*real_gai_strerror)(int errcode);
 FILE* (*real_fopen)(const char *path, const char *mode);
 mode_t (*real_umask)(mode_t cmask);
 ssize_t (*real_writev)(int fildes, const struct iovec *iov, int iovcnt);
+ssize_t (*real_readv)(int fildes, const struct iovec *iov, int iovcnt);
 
 #ifdef __MACH__
 #else
@@ -126,9 +127,25 @@ void _native_syscall_leave(void)
         native_isr_context.uc_stack.ss_flags = 0;
         native_interrupts_enabled = 0;
         makecontext(&native_isr_context, native_irq_handler, 0);
-        if (swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
+#ifdef NATIVE_ASM_SWITCH
+        uint8_t fpu[NATIVE_FPU_CTX_SIZE];
+
+        /* swapcontext(3) would have blocked signals with the mask of the
+         * ISR context and saved the FPU environment */
+        if (sigprocmask(SIG_SETMASK, &_native_sig_set_dint, NULL) == -1) {
+            err(EXIT_FAILURE, "_native_syscall_leave: sigprocmask");
+        }
+        _native_fpu_save(fpu);
+#endif
+        if (_native_swapcontext(_native_cur_ctx, &native_isr_context) == -1) {
             err(EXIT_FAILURE, "_native_syscall_leave: swapcontext");
         }
+#ifdef NATIVE_ASM_SWITCH
+        _native_fpu_restore(fpu);
+        /* swapcontext(3) would have restored the unblocked signal mask
+         * this context was saved with */
+        irq_enable();
+#endif
     }
 }
 
@@ -472,6 +489,7 @@ void _native_init_syscalls(void)
     *(void **)(&real_clearerr) = dlsym(RTLD_NEXT, "clearerr");
     *(void **)(&real_umask) = dlsym(RTLD_NEXT, "umask");
     *(void **)(&real_writev) = dlsym(RTLD_NEXT, "writev");
+    *(void **)(&real_readv) = dlsym(RTLD_NEXT, "readv");
 #ifdef __MACH__
 #else
     *(void **)(&real_clock_gettime) = dlsym(RTLD_NEXT, "clock_gettime");
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Turn a scheduler trace written by `schedtrace dump <file>` on native into a
+timeline.
+
+Without options the events and the time each thread ran between two context
+switches are printed as text. With --chrome a JSON file for chrome://tracing
+(or any other viewer of the Trace Event Format) is written instead.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"RIOTTRC"
+VERSION = 1
+# uint32_t time, kernel_pid_t from, kernel_pid_t to, uint8_t reason
+ENTRY = struct.Struct("=IhhB")
+
+REASONS = ["switch", "irq", "bl send", "bl rx", "bl reply"]
+SWITCH = 0
+IRQ = 1
+
+
+def read_trace(filename):
+    with open(filename, "rb") as f:
+        data = f.read()
+
+    if data[:len(MAGIC)] != MAGIC:
+        raise ValueError("%s is not a scheduler trace" % filename)
+    if data[len(MAGIC)] != VERSION:
+        raise ValueError("unsupported trace version %d" % data[len(MAGIC)])
+
+    hz, num, size = struct.unpack_from("=III", data, 8)
+    entries = []
+    for i in range(num):
+        entries.append(ENTRY.unpack_from(data, 20 + i * size))
+
+    return hz, _unwrap(entries)
+
+
+def _unwrap(entries):
+    """convert the 32-bit time stamps to monotonic ones"""
+    res = []
+    offset = 0
+    last = None
+    for time, src, dst, reason in entries:
+        if last is not None and time < last:
+            offset += 1 << 32
+        last = time
+        res.append((time + offset, src, dst, reason))
+    return res
+
+
+def slices(entries):
+    """yield (start, end, pid) for every period a thread ran"""
+    start = None
+    pid = None
+    for time, src, dst, reason in entries:
+        if reason != SWITCH:
+            continue
+        if start is not None:
+            yield start, time, pid
+        start = time
+        pid = dst
+
+
+def print_timeline(hz, entries):
+    to_us = 1000000.0 / hz
+    base = entries[0][0] if entries else 0
+
+    print("%12s  %-8s  %5s  %5s" % ("time [us]", "reason", "from", "to"))
+    for time, src, dst, reason in entries:
+        print("%12.1f  %-8s  %5d  %5d" % ((time - base) * to_us,
+                                           REASONS[reason], src, dst))
+
+    total = {}
+    for start, end, pid in slices(entries):
+        total[pid] = total.get(pid, 0) + end - start
+    duration = sum(total.values())
+    if duration:
+        print("\n%5s  %12s  %6s" % ("pid", "runtime [us]", "cpu"))
+        for pid in sorted(total):
+            print("%5d  %12.1f  %5.1f%%" % (pid, total[pid] * to_us,
+                                           100.0 * total[pid] / duration))
+
+
+def write_chrome(hz, entries, filename):
+    to_us = 1000000.0 / hz
+    events = []
+    for start, end, pid in slices(entries):
+        events.append({"name": "pid %d" % pid, "ph": "X", "pid": 0,
+                       "tid": pid, "ts": start * to_us,
+                       "dur": (end - start) * to_us})
+    for time, src, dst, reason in entries:
+        if reason == SWITCH:
+            continue
+        name = "irq %d" % dst if reason == IRQ else REASONS[reason]
+        events.append({"name": name, "ph": "i", "s": "t", "pid": 0,
+                       "tid": src, "ts": time * to_us})
+    with open(filename, "w") as f:
+        json.dump({"traceEvents": events}, f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("trace", help="file written by 'schedtrace dump'")
+    parser.add_argument("--chrome", metavar="JSON",
+                        help="write a Trace Event Format file")
+    args = parser.parse_args()
+
+    try:
+        hz, entries = read_trace(args.trace)
+    except (IOError, ValueError, struct.error) as e:
+        sys.exit("error: %s" % e)
+
+    if args.chrome:
+        write_chrome(hz, entries, args.chrome)
+    else:
+        print_timeline(hz, entries)
+
+
+if __name__ == "__main__":
+    main()
@@ -28,6 +28,23 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   The UDP or ICMPv6 checksum of the frame was verified by the device
+ *
+ * Only set for IPv6 packets whose upper layer header directly follows the
+ * IPv6 header by devices supporting @ref NETOPT_CSUM_OFFLOAD_RX.
+ */
+#define NETDEV2_ETH_RX_CSUM_VALID   (0x01)
+
+/**
+ * @brief   Received frame status information for Ethernet devices
+ *
+ * Devices that do not provide any may ignore it.
+ */
+typedef struct {
+    uint8_t flags;      /**< flags as defined above */
+} netdev2_eth_rx_info_t;
+
 /**
  * @brief   Fallback function for netdev2 ethernet devices' _get function
  *
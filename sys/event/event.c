@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "assert.h"
+#include "event.h"
+#include "irq.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && queue->waiter && event);
+
+    unsigned state = irq_disable();
+    if (!event->list_node.next) {
+        clist_rpush(&queue->event_list, &event->list_node);
+    }
+    else {
+        DEBUG("event_post(): event %p already queued\n", (void *)event);
+    }
+    irq_restore(state);
+
+    thread_flags_set(queue->waiter, THREAD_FLAG_EVENT);
+}
+
+void event_cancel(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    if (clist_remove(&queue->event_list, &event->list_node)) {
+        event->list_node.next = NULL;
+    }
+    irq_restore(state);
+}
+
+/* must be called with interrupts disabled */
+static event_t *_pop(event_queue_t *queue)
+{
+    event_t *result = (event_t *)clist_lpop(&queue->event_list);
+
+    /* mark as not queued before interrupts get enabled again, so the event
+     * can be posted again right away */
+    if (result) {
+        result->list_node.next = NULL;
+    }
+    return result;
+}
+
+event_t *event_get(event_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    event_t *result = _pop(queue);
+
+    irq_restore(state);
+    return result;
+}
+
+event_t *event_wait(event_queue_t *queue)
+{
+    event_t *result;
+
+    while (1) {
+        unsigned state = irq_disable();
+        result = _pop(queue);
+        irq_restore(state);
+        if (result) {
+            return result;
+        }
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Allocation-free event queues based on thread flags
+ *
+ * An event queue is a list of intrusive @ref event_t nodes that belongs to a
+ * single thread. Posting an event appends it to the queue and sets
+ * @ref THREAD_FLAG_EVENT on the owning thread. Compared to sending a
+ * @ref msg_t this
+ *
+ * - cannot fail, as no queue slot is needed: events can safely be posted from
+ *   interrupt context and are never dropped,
+ * - coalesces: posting an event that is already queued has no effect, so an
+ *   event handler runs at most once per posting burst,
+ * - is O(1) for posting and getting events.
+ *
+ * An event is usually embedded into a larger structure, the handler can then
+ * use container_of() to get to its context.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(event_t *event)
+ * {
+ *     puts("event triggered");
+ * }
+ *
+ * static event_t event = { .handler = _handler };
+ *
+ * static void *_thread(void *arg)
+ * {
+ *     event_queue_t queue;
+ *
+ *     event_queue_init(&queue);
+ *     event_loop(&queue);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event queue API
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "assert.h"
+#include "clist.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag used to signal a thread that events are pending
+ */
+#ifndef THREAD_FLAG_EVENT
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   Static initializer for an event queue owned by the calling thread
+ */
+#define EVENT_QUEUE_INIT    { .waiter = (thread_t *)sched_active_thread }
+
+/**
+ * @brief   event structure forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   event handler type definition
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry             */
+    event_handler_t handler;    /**< pointer to event handler function  */
+};
+
+/**
+ * @brief   event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events              */
+    thread_t *waiter;           /**< thread owning the event queue      */
+} event_queue_t;
+
+/**
+ * @brief   Initialize an event queue for the calling thread
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+static inline void event_queue_init(event_queue_t *queue)
+{
+    assert(queue);
+    memset(queue, '\0', sizeof(*queue));
+    queue->waiter = (thread_t *)sched_active_thread;
+}
+
+/**
+ * @brief   Queue an event
+ *
+ * If @p event is already queued, this function does nothing. May be called
+ * from interrupt context.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue in event queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * This will remove a queued event from an event queue. If @p event is not
+ * queued, this function does nothing.
+ *
+ * @note    Due to the underlying list implementation, this will run in O(n).
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove from queue
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get next event from event queue, non-blocking
+ *
+ * In order to handle an event retrieved using this function,
+ * call event->handler(event).
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if no event available
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get next event from event queue, blocking
+ *
+ * This function will block until an event becomes available.
+ *
+ * @note    Must only be called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Simple event loop
+ *
+ * This function will forever sit in a loop, waiting for events to be queued
+ * and executing their handlers.
+ *
+ * @param[in]   queue   event queue to process
+ */
+static inline void event_loop(event_queue_t *queue)
+{
+    event_t *event;
+
+    while ((event = event_wait(queue))) {
+        event->handler(event);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
@@ -59,6 +59,12 @@ typedef struct {
  */
 #define FIB_MSG_RP_SIGNAL_SOURCE_ROUTE_CREATED (0x97)
 
+/**
+ * @brief message type for expiry notification: entries of the FIB table in
+ *        msg_t::content::ptr are due to expire, call fib_expire() on it
+ */
+#define FIB_MSG_EXPIRE (0x96)
+
 /**
  * @brief entry used to collect available destinations
  */
@@ -465,6 +471,38 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
  */
 int fib_get_num_used_entries(fib_table_t *table);
 
+/**
+ * @brief returns the number of entries that were removed because their
+ *        lifetime expired since the table was initialized
+ *
+ * @param[in] table         the fib instance to check
+ */
+uint32_t fib_get_num_expired_entries(fib_table_t *table);
+
+/**
+ * @brief Sets the thread that removes expired entries of a single hop table
+ *
+ * Entries with a lifetime are kept ordered by their expiry time, and a timer
+ * fires when the first of them expires. The timer then sends a message of
+ * type @ref FIB_MSG_EXPIRE to @p pid, which must call fib_expire() on
+ * receiving it. This way lookups never remove entries themselves. If the
+ * message queue of @p pid is full, the message is sent again shortly after.
+ *
+ * Without such a thread (the default), the next call on the table after the
+ * timer fired removes the expired entries.
+ *
+ * @param[in] table         the fib instance
+ * @param[in] pid           the thread to notify, KERNEL_PID_UNDEF for none
+ */
+void fib_set_expiry_thread(fib_table_t *table, kernel_pid_t pid);
+
+/**
+ * @brief Removes all entries whose lifetime expired from a single hop table
+ *
+ * @param[in] table         the fib instance
+ */
+void fib_expire(fib_table_t *table);
+
 /**
  * @brief Prints the kernel_pid_t for all registered RRPs
  */
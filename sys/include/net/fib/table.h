@@ -19,11 +19,13 @@
 #ifndef FIB_TABLE_H_
 #define FIB_TABLE_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +37,19 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Node of the longest prefix match index of a FIB table
+ *
+ * @internal
+ */
+typedef struct {
+    uint16_t child[2];  /**< nodes below, by the bit after the key bits */
+    uint16_t parent;    /**< node above */
+    uint16_t bits;      /**< number of significant key bits */
+    uint16_t key;       /**< index of the entry holding the key bits */
+    uint16_t dup;       /**< next entry with the same key bits */
+} fib_lpm_node_t;
+
 /**
  * @brief Container descriptor for a FIB entry
  */
@@ -51,6 +66,12 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+    /** Nodes of the longest prefix match index, managed by the FIB */
+    fib_lpm_node_t lpm[2];
+    /** previous entry in the expiry order, managed by the FIB */
+    uint16_t expiry_prev;
+    /** next entry in the expiry order, managed by the FIB */
+    uint16_t expiry_next;
 } fib_entry_t;
 
 /**
@@ -117,7 +138,9 @@ typedef struct {
     *   This value indicates what is stored in `data` of this table
     */
     uint8_t table_type;
-    /** the maximim number of entries in this FIB table */
+    /** the maximim number of entries in this FIB table,
+    *   less than 32767 for single hop tables
+    */
     size_t size;
     /** table access mutex to grant exclusive operations on calls */
     mutex_t mtx_access;
@@ -133,6 +156,24 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** root node of the longest prefix match index of single hop tables */
+    uint16_t lpm_root;
+    /** first unused branch node of the longest prefix match index */
+    uint16_t lpm_free;
+    /** entry of single hop tables that expires next */
+    uint16_t expiry_head;
+    /** set by fib_table_t::expiry_timer when entries are due to expire */
+    volatile bool expiry_pending;
+    /** thread that is told to call fib_expire(), KERNEL_PID_UNDEF if none */
+    kernel_pid_t expiry_pid;
+    /** timer firing at the next expiry deadline */
+    xtimer_t expiry_timer;
+    /** number of entries removed since fib_init() because they expired */
+    uint32_t expired;
+    /** incremented whenever an entry of a single hop table is added, removed
+     *  or gets another next hop, so users can tell if a result they
+     *  remembered is still valid */
+    uint32_t version;
 } fib_table_t;
 
 #ifdef __cplusplus
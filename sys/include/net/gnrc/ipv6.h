@@ -68,6 +68,13 @@ extern "C" {
 #define GNRC_IPV6_MSG_QUEUE_SIZE    (8U)
 #endif
 
+/**
+ * @brief   Maximum number of messages the IPv6 thread handles per wakeup.
+ */
+#ifndef GNRC_IPV6_MSG_BURST_SIZE
+#define GNRC_IPV6_MSG_BURST_SIZE    (4U)
+#endif
+
 /**
  * @brief   The PID to the IPv6 thread.
  *
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_dcache IPv6 destination cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Remembers the next hop of recently used unicast destinations.
+ *
+ * Without the destination cache @ref net_gnrc_ipv6 looks up the FIB and the
+ * neighbor cache and selects a source address for every packet it sends.
+ * With it, this is only done for the first packet to a destination, later
+ * packets use the interface, the link layer address of the next hop and the
+ * source address found for the first one.
+ *
+ * The cache is flushed whenever the FIB, the neighbor cache or the addresses
+ * of an interface change, so the next packet to every destination takes the
+ * long way again. Entries are added by the IPv6 thread only.
+ *
+ * @{
+ *
+ * @file
+ * @brief   IPv6 destination cache definitions
+ */
+#ifndef GNRC_IPV6_DCACHE_H_
+#define GNRC_IPV6_DCACHE_H_
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GNRC_IPV6_DCACHE_SIZE
+/**
+ * @brief   Number of entries of the destination cache
+ *
+ * @note    Must be a power of 2.
+ */
+#define GNRC_IPV6_DCACHE_SIZE       (8)
+#endif
+
+/**
+ * @brief   Destination cache entry
+ */
+typedef struct {
+    ipv6_addr_t dst;                            /**< the destination */
+    ipv6_addr_t src;                            /**< source address to use for
+                                                 *   gnrc_ipv6_dcache_t::dst, unspecified
+                                                 *   if there is none */
+    uint8_t l2addr[GNRC_IPV6_NC_L2_ADDR_MAX];   /**< link layer address of the next hop */
+    uint8_t l2addr_len;                         /**< length of gnrc_ipv6_dcache_t::l2addr */
+    kernel_pid_t req_iface;                     /**< interface the sender asked for,
+                                                 *   KERNEL_PID_UNDEF for any */
+    kernel_pid_t iface;                         /**< interface to the next hop */
+    uint16_t mtu;                               /**< MTU of the path to the destination,
+                                                 *   i.e. the MTU of gnrc_ipv6_dcache_t::iface */
+    uint32_t gen;                               /**< generation the entry was added in
+                                                 *   (internal) */
+#if defined(MODULE_FIB) || defined(DOXYGEN)
+    uint32_t fib_version;                       /**< version of the FIB the entry was
+                                                 *   added for (internal) */
+#endif
+} gnrc_ipv6_dcache_t;
+
+/**
+ * @brief   Statistics of the destination cache
+ */
+typedef struct {
+    uint32_t hits;      /**< lookups answered by the cache */
+    uint32_t misses;    /**< lookups that were not */
+    uint32_t flushes;   /**< number of times the cache was flushed */
+} gnrc_ipv6_dcache_stats_t;
+
+/**
+ * @brief   Looks up a destination
+ *
+ * On a miss the state of the FIB and of the cache is remembered for the
+ * next call of gnrc_ipv6_dcache_add().
+ *
+ * @param[in] iface     The interface the packet shall be sent over,
+ *                      KERNEL_PID_UNDEF for any.
+ * @param[in] dst       A unicast destination address.
+ *
+ * @return  The entry for @p dst, if there is a valid one.
+ * @return  NULL, if there is none.
+ */
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_get(kernel_pid_t iface, const ipv6_addr_t *dst);
+
+/**
+ * @brief   Adds a destination after it missed
+ *
+ * The source address and the MTU are taken from the interface. Must be
+ * called after gnrc_ipv6_dcache_get() missed @p dst, the entry is not valid
+ * if the cache was flushed in between.
+ *
+ * @param[in] req_iface     The interface given to gnrc_ipv6_dcache_get().
+ * @param[in] dst           The destination.
+ * @param[in] iface         The interface to the next hop.
+ * @param[in] l2addr        The link layer address of the next hop.
+ * @param[in] l2addr_len    Length of @p l2addr, must not be greater than
+ *                          @ref GNRC_IPV6_NC_L2_ADDR_MAX.
+ *
+ * @return  The new entry.
+ * @return  NULL, if @p l2addr_len is too big.
+ */
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_add(kernel_pid_t req_iface, const ipv6_addr_t *dst,
+                                         kernel_pid_t iface, const uint8_t *l2addr,
+                                         uint8_t l2addr_len);
+
+/**
+ * @brief   Invalidates all entries
+ *
+ * Called when anything the next hop or the source address of a destination
+ * depends on changes. May be called from any thread.
+ */
+void gnrc_ipv6_dcache_flush(void);
+
+/**
+ * @brief   Gets the next valid entry after @p prev
+ *
+ * @param[in] prev  Previous entry. NULL to start iteration.
+ *
+ * @return  The next valid entry.
+ * @return  NULL, if there is none.
+ */
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_get_next(gnrc_ipv6_dcache_t *prev);
+
+/**
+ * @brief   Gets the statistics of the destination cache
+ *
+ * @param[out] stats    The statistics
+ */
+void gnrc_ipv6_dcache_get_stats(gnrc_ipv6_dcache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_DCACHE_H_ */
+/** @} */
@@ -44,6 +44,24 @@ extern "C" {
 #define GNRC_IPV6_NC_SIZE           (GNRC_NETIF_NUMOF * 8)
 #endif
 
+#ifndef GNRC_IPV6_NC_BUCKETS
+/**
+ * @brief   Number of hash buckets of the neighbor cache
+ *
+ * @note    Must be a power of 2. Defaults to roughly a quarter of
+ *          @ref GNRC_IPV6_NC_SIZE.
+ */
+#if GNRC_IPV6_NC_SIZE >= 1024
+#define GNRC_IPV6_NC_BUCKETS        (256)
+#elif GNRC_IPV6_NC_SIZE >= 256
+#define GNRC_IPV6_NC_BUCKETS        (64)
+#elif GNRC_IPV6_NC_SIZE >= 64
+#define GNRC_IPV6_NC_BUCKETS        (16)
+#else
+#define GNRC_IPV6_NC_BUCKETS        (4)
+#endif
+#endif
+
 #ifndef GNRC_IPV6_NC_L2_ADDR_MAX
 /**
  * @brief   The maximum size of a link layer address
@@ -163,11 +181,29 @@ typedef struct {
 #endif
 
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
+    uint16_t next;                          /**< next entry in the same hash bucket or
+                                             *   free list (internal) */
+    uint16_t lru_prev;                      /**< more recently used entry (internal) */
+    uint16_t lru_next;                      /**< less recently used entry (internal) */
     /**
      * @}
      */
 } gnrc_ipv6_nc_t;
 
+/**
+ * @brief   Statistics of the neighbor cache
+ */
+typedef struct {
+    /**
+     * @brief   Number of entries per state, indexed by the state as returned
+     *          by gnrc_ipv6_nc_get_state()
+     */
+    uint16_t states[GNRC_IPV6_NC_STATE_MASK + 1];
+    uint16_t entries;       /**< number of entries in use */
+    uint32_t evictions;     /**< entries replaced to make room for a new one */
+    uint32_t full;          /**< additions failed since nothing could be evicted */
+} gnrc_ipv6_nc_stats_t;
+
 /**
  * @brief   Initializes neighbor cache
  */
@@ -183,6 +219,10 @@ void gnrc_ipv6_nc_init(void);
  *                          to GNRC_IPV6_L2_ADDR_MAX. 0 if unknown.
  * @param[in] flags         Flags for the entry
  *
+ * If the neighbor cache is full the least recently used entry, that is in
+ * state @ref GNRC_IPV6_NC_STATE_STALE or @ref GNRC_IPV6_NC_STATE_UNMANAGED,
+ * no router and neither registered nor tentative, is replaced.
+ *
  * @return  Pointer to new neighbor cache entry on success
  * @return  NULL, on failure
  */
@@ -212,6 +252,13 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
  */
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr);
 
+/**
+ * @brief   Gets the statistics of the neighbor cache
+ *
+ * @param[out] stats    The statistics
+ */
+void gnrc_ipv6_nc_get_stats(gnrc_ipv6_nc_stats_t *stats);
+
 /**
  * @brief   Gets next entry in neighbor cache after @p prev.
  *
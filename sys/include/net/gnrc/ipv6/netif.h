@@ -203,6 +203,12 @@ extern "C" {
  */
 #define GNRC_IPV6_NETIF_FLAGS_IS_WIRED          (0x0080)
 
+/**
+ * @brief   Flag to indicate that the interface fills in UDP and ICMPv6
+ *          checksums itself (see @ref NETOPT_CSUM_OFFLOAD_TX)
+ */
+#define GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD_TX   (0x0100)
+
 /**
  * @brief   Offset of the router advertisement flags compared to the position in router
  *          advertisements.
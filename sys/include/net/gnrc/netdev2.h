@@ -32,6 +32,7 @@
 #include <assert.h>
 #include <stdint.h>
 
+#include "event.h"
 #include "kernel_types.h"
 #include "net/netdev2.h"
 #include "net/gnrc.h"
@@ -97,6 +98,16 @@ typedef struct gnrc_netdev2 {
      */
     kernel_pid_t pid;
 
+    /**
+     * @brief Event queue of this adapter's thread
+     */
+    event_queue_t evq;
+
+    /**
+     * @brief Event posted to @ref gnrc_netdev2_t::evq by the device's ISR
+     */
+    event_t event_isr;
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
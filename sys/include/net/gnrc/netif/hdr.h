@@ -21,6 +21,7 @@
 #ifndef NETIF_HDR_H_
 #define NETIF_HDR_H_
 
+#include <stdbool.h>
 #include <string.h>
 #include <stdint.h>
 
@@ -65,6 +66,17 @@ extern "C" {
  *          this flag the same way it does @ref GNRC_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
+
+/**
+ * @brief   Checksum of received packet was verified.
+ *
+ * @details Set for received packets if the network device already verified
+ *          the UDP or ICMPv6 checksum of an IPv6 packet whose upper layer
+ *          header directly follows the IPv6 header (see
+ *          @ref NETOPT_CSUM_OFFLOAD_RX). The upper layer does not need to
+ *          verify it again.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM_VALID (0x20)
 /**
  * @}
  */
@@ -192,6 +204,24 @@ static inline void gnrc_netif_hdr_set_dst_addr(gnrc_netif_hdr_t *hdr, uint8_t *a
  */
 gnrc_pktsnip_t *gnrc_netif_hdr_build(uint8_t *src, uint8_t src_len, uint8_t *dst, uint8_t dst_len);
 
+/**
+ * @brief   Checks if the network device verified the checksum of a received
+ *          packet
+ *
+ * @param[in] pkt   A received packet.
+ *
+ * @return  true, if the generic network interface header of @p pkt has
+ *          @ref GNRC_NETIF_HDR_FLAGS_CSUM_VALID set.
+ * @return  false, otherwise.
+ */
+static inline bool gnrc_netif_hdr_csum_valid(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+
+    return (netif != NULL) &&
+           (((gnrc_netif_hdr_t *)netif->data)->flags & GNRC_NETIF_HDR_FLAGS_CSUM_VALID);
+}
+
 /**
  * @brief   Outputs a generic interface header to stdout.
  *
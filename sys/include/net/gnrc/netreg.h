@@ -55,6 +55,19 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @def     GNRC_NETREG_BUCKETS
+ * @brief   Number of hash buckets per @ref gnrc_nettype_t in the registry
+ *
+ * @details Entries are hashed by their gnrc_netreg_entry_t::demux_ctx, so
+ *          gnrc_netreg_lookup() only walks the entries in one bucket. Must
+ *          be a power of 2. Set to 1 to keep a single list per type, e.g. on
+ *          nodes with very few registrations.
+ */
+#ifndef GNRC_NETREG_BUCKETS
+#define GNRC_NETREG_BUCKETS         (8U)
+#endif
+
 /**
  * @brief   Initializes a netreg entry statically with PID
  *
@@ -266,6 +279,9 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
  * @warning Call gnrc_netreg_unregister() *before* you leave the context you
  *          allocated @p entry in. Otherwise it might get overwritten.
  *
+ * @note    gnrc_netreg_entry_t::demux_ctx of @p entry must not be changed
+ *          while it is registered.
+ *
  * @pre The calling thread must provide a message queue.
  *
  * @return  0 on success
@@ -23,6 +23,7 @@
 #define GNRC_PKT_H_
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 #include "kernel_types.h"
@@ -115,6 +116,27 @@ typedef struct gnrc_pktsnip {
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+    /**
+     * @brief   Bytes in front of gnrc_pktsnip_t::data that were allocated
+     *          together with it, see gnrc_pktbuf_add_headroom()
+     *
+     * @internal
+     */
+    uint16_t headroom;
+    /**
+     * @brief   Bytes of gnrc_pktsnip_t::headroom not yet claimed by
+     *          gnrc_pktbuf_prepend()
+     *
+     * @internal
+     */
+    uint16_t headroom_free;
+    /**
+     * @brief   gnrc_pktsnip_t::data lies in the headroom of a following snip
+     *          and is freed with that snip
+     *
+     * @internal
+     */
+    bool borrowed;
 } gnrc_pktsnip_t;
 
 /**
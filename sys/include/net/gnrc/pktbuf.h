@@ -51,14 +51,67 @@ extern "C" {
  *
  * @details The rational here is to have at least space for 4 full-MTU IPv6
  *          packages (2 incoming, 2 outgoing; 2 * 2 * 1280 B = 5 KiB) +
- *          Meta-Data (roughly estimated to 1 KiB; might be smaller). If
- *          @ref GNRC_PKTBUF_SIZE is 0 the packet buffer will use dynamic memory
- *          management to allocate packets.
+ *          Meta-Data (roughly estimated to 1 KiB; might be smaller). With
+ *          the `gnrc_pktbuf_malloc` module packets are allocated from the
+ *          heap instead, see @ref GNRC_PKTBUF_MALLOC_LIMIT.
  */
 #ifndef GNRC_PKTBUF_SIZE
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @def     GNRC_PKTBUF_HEADROOM
+ * @brief   Headroom transport layers reserve in front of outgoing payload
+ *
+ * @details Lower layers prepend their headers into this space with
+ *          gnrc_pktbuf_prepend(), so header and payload end up in one
+ *          contiguous buffer. The default fits a UDP and an IPv6 header.
+ *          Set it to 0 to allocate every header separately.
+ */
+#ifndef GNRC_PKTBUF_HEADROOM
+#define GNRC_PKTBUF_HEADROOM        (48)
+#endif
+
+/**
+ * @def     GNRC_PKTBUF_SNIP_NUMOF
+ * @brief   Number of packet snip descriptors in the descriptor slab
+ *
+ * @details Only used with the `gnrc_pktbuf_slab` module. Descriptors are then
+ *          taken from a dedicated pool in O(1) instead of from the
+ *          @ref GNRC_PKTBUF_SIZE byte data arena. The default allows for
+ *          one descriptor per 96 bytes of the arena.
+ */
+#ifndef GNRC_PKTBUF_SNIP_NUMOF
+#define GNRC_PKTBUF_SNIP_NUMOF      (GNRC_PKTBUF_SIZE / 96)
+#endif
+
+/**
+ * @def     GNRC_PKTBUF_NETIF_HDR_NUMOF
+ * @brief   Number of slab blocks for @ref GNRC_NETTYPE_NETIF headers
+ *
+ * @details Only used with the `gnrc_pktbuf_slab` module. Each block fits a
+ *          netif header with two addresses of the maximum length. When all
+ *          blocks are in use, headers are allocated from the data arena.
+ */
+#ifndef GNRC_PKTBUF_NETIF_HDR_NUMOF
+#define GNRC_PKTBUF_NETIF_HDR_NUMOF (16)
+#endif
+
+/**
+ * @def     GNRC_PKTBUF_CACHE_SIZE
+ * @brief   Number of slab blocks per class a thread keeps for itself
+ *
+ * @details Only used with the `gnrc_pktbuf_cache` module. Every thread then
+ *          keeps up to this many snip descriptors and netif header blocks,
+ *          which are allocated and released without locking the packet
+ *          buffer. An empty cache is refilled with half of this number of
+ *          blocks from the slab. Cached blocks count as used in
+ *          @ref gnrc_pktbuf_alloc_stats_t::snips_used.
+ */
+#ifndef GNRC_PKTBUF_CACHE_SIZE
+#define GNRC_PKTBUF_CACHE_SIZE      (8)
+#endif
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -88,6 +141,54 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
                                 gnrc_nettype_t type);
 
+/**
+ * @brief   Adds a new gnrc_pktsnip_t with free space in front of its data to
+ *          the packet buffer.
+ *
+ * @details Works like gnrc_pktbuf_add(), but additionally allocates
+ *          @p headroom bytes directly in front of the snip's data. Lower
+ *          layers can claim that space with gnrc_pktbuf_prepend(), so their
+ *          headers and the payload form one contiguous buffer.
+ *
+ * @pre (size + headroom) < GNRC_PKTBUF_SIZE
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Data of the new gnrc_pktsnip_t. If @p data is NULL no
+ *                      data will be inserted into `result`.
+ * @param[in] size      Length of @p data.
+ * @param[in] headroom  Number of bytes to reserve in front of the data.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type);
+
+/**
+ * @brief   Adds a new header of @p size bytes in front of @p pkt
+ *
+ * @details If @p pkt is the first snip of a buffer allocated with
+ *          gnrc_pktbuf_add_headroom() and enough headroom is left, the new
+ *          snip's data is placed directly in front of @p pkt's data without
+ *          a new data allocation. Otherwise this works like
+ *          `gnrc_pktbuf_add(pkt, NULL, size, type)`.
+ *
+ * @note    Snips in the headroom of another snip are freed with that snip,
+ *          so they must not be kept beyond its release.
+ *
+ * @param[in] pkt   The packet to prepend the header to. May be NULL.
+ * @param[in] size  Length of the new header.
+ * @param[in] type  Protocol type of the new header.
+ *
+ * @return  The new head of the packet.
+ * @return  NULL, if no space is left in the packet buffer.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_prepend(gnrc_pktsnip_t *pkt, size_t size,
+                                    gnrc_nettype_t type);
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -144,6 +245,9 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size);
 /**
  * @brief   Increases gnrc_pktsnip_t::users of @p pkt atomically.
  *
+ * @note    This function never blocks and may be called from interrupt
+ *          context.
+ *
  * @param[in] pkt   A packet.
  * @param[in] num   Number you want to increment gnrc_pktsnip_t::users of @p pkt by.
  */
@@ -154,6 +258,10 @@ void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num);
  *          reaches 0 and reports a possible error through an error code, if
  *          @ref net_gnrc_neterr is included.
  *
+ * @note    With `gnrc_pktbuf_static` this function never blocks. Memory that
+ *          cannot be freed right away because another thread holds the packet
+ *          buffer is returned by the next operation that locks it.
+ *
  * @pre All snips of @p pkt must be in the packet buffer.
  *
  * @param[in] pkt   A packet.
@@ -193,7 +301,10 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt);
  *
  * @details This function will create a new packet snip in the packet buffer,
  *          which points to the given *pkt* and contains a IOVEC representation
- *          of the referenced packet in its data section.
+ *          of the referenced packet in its data section. Snips after the
+ *          first one whose data directly follows the data of the previous
+ *          snip, e.g. headers prepended with gnrc_pktbuf_prepend(), share a
+ *          single element.
  *
  * @param[in]  pkt  Packet to export as IOVEC
  * @param[out] len  Number of elements in the IOVEC
@@ -285,6 +396,116 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
 void gnrc_pktbuf_stats(void);
 #endif
 
+#if defined(MODULE_GNRC_PKTBUF_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Allocation statistics of the packet buffer
+ */
+typedef struct {
+    uint32_t alloc_num;         /**< number of data arena allocations */
+    uint32_t alloc_fail;        /**< number of failed allocations */
+    uint32_t alloc_walk;        /**< free chunks visited by all arena
+                                 *   allocations */
+    uint32_t alloc_walk_max;    /**< most free chunks visited by a single
+                                 *   arena allocation */
+    size_t free_bytes;          /**< free bytes in the data arena */
+    size_t free_chunks;         /**< number of free chunks in the data arena */
+    size_t largest_free;        /**< largest free chunk in the data arena.
+                                 *   `free_bytes - largest_free` is lost to
+                                 *   fragmentation for a single allocation */
+    unsigned snips_used;        /**< descriptors in use in the snip slab */
+    unsigned snips_max;         /**< most descriptors ever in use in the snip
+                                 *   slab */
+} gnrc_pktbuf_alloc_stats_t;
+
+/**
+ * @brief   Gets the allocation statistics of the packet buffer
+ *
+ * @note    Only available with the `gnrc_pktbuf_stats` module. The slab
+ *          fields are only set with `gnrc_pktbuf_slab`. For
+ *          `gnrc_pktbuf_malloc` the data arena is the room left below the
+ *          soft cap and the snip fields count all descriptors.
+ *
+ * @param[out] stats    the current statistics
+ */
+void gnrc_pktbuf_get_alloc_stats(gnrc_pktbuf_alloc_stats_t *stats);
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Returns all blocks cached by the calling thread to the slab
+ *
+ * @details Blocks in a thread's cache are not available to other threads,
+ *          so a thread that stops using the packet buffer, e.g. before it
+ *          exits, should call this function. Does nothing in interrupt
+ *          context.
+ */
+void gnrc_pktbuf_cache_flush(void);
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_MALLOC) || defined(DOXYGEN)
+/**
+ * @def     GNRC_PKTBUF_MALLOC_LIMIT
+ * @brief   Default soft cap in bytes for the `gnrc_pktbuf_malloc`
+ *          implementation
+ *
+ * @details Data and snip descriptors are counted against it, without the
+ *          allocator's own overhead. It can be changed at run-time with
+ *          gnrc_pktbuf_malloc_set_limit().
+ */
+#ifndef GNRC_PKTBUF_MALLOC_LIMIT
+#define GNRC_PKTBUF_MALLOC_LIMIT    (4 * GNRC_PKTBUF_SIZE)
+#endif
+
+/**
+ * @brief   Allocator used by the `gnrc_pktbuf_malloc` implementation
+ *
+ * @details The functions are called with the packet buffer locked, but
+ *          must be safe against other users of the same heap.
+ */
+typedef struct {
+    void *(*alloc)(size_t size);    /**< allocates @p size bytes, returns
+                                     *   NULL on failure */
+    void (*free)(void *ptr);        /**< frees memory returned by
+                                     *   gnrc_pktbuf_allocator_t::alloc */
+} gnrc_pktbuf_allocator_t;
+
+/**
+ * @brief   Sets the allocator of the packet buffer
+ *
+ * @details By default malloc() and free() are used. A private pool needs an
+ *          allocator with a control structure of its own, pkg/tlsf serves
+ *          only the single system heap.
+ *
+ * @pre The packet buffer is empty
+ *
+ * @param[in] allocator The new allocator. Must stay valid while in use.
+ */
+void gnrc_pktbuf_malloc_set_allocator(const gnrc_pktbuf_allocator_t *allocator);
+
+/**
+ * @brief   Sets the soft cap of the packet buffer
+ *
+ * @details Allocations that would exceed @p limit fail. Lowering the cap
+ *          below the current usage does not affect packets already in the
+ *          buffer.
+ *
+ * @param[in] limit The new soft cap in bytes.
+ */
+void gnrc_pktbuf_malloc_set_limit(size_t limit);
+
+/**
+ * @brief   Gets the number of data bytes allocated for a protocol type
+ *
+ * @details Data is accounted to the type its snip had when the data was
+ *          allocated, even if gnrc_pktsnip_t::type is changed later.
+ *
+ * @param[in] type  A protocol type.
+ *
+ * @return  Data bytes allocated for @p type.
+ */
+size_t gnrc_pktbuf_malloc_usage(gnrc_nettype_t type);
+#endif
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
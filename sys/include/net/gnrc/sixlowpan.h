@@ -133,6 +133,13 @@ extern "C" {
 #define GNRC_SIXLOWPAN_MSG_QUEUE_SIZE   (8U)
 #endif
 
+/**
+ * @brief   Maximum number of messages the 6LoWPAN thread handles per wakeup.
+ */
+#ifndef GNRC_SIXLOWPAN_MSG_BURST_SIZE
+#define GNRC_SIXLOWPAN_MSG_BURST_SIZE   (4U)
+#endif
+
 /**
  * @brief   Initialization of the 6LoWPAN thread.
  *
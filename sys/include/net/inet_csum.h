@@ -27,6 +27,20 @@
 extern "C" {
 #endif
 
+#ifndef INET_CSUM_SSE2
+/**
+ * @brief   Sum up large buffers with SSE2 instructions
+ *
+ * Defaults to 1 if the compiler targets SSE2, e.g. on native with
+ * `CFLAGS += -msse2`.
+ */
+#ifdef __SSE2__
+#define INET_CSUM_SSE2  (1)
+#else
+#define INET_CSUM_SSE2  (0)
+#endif
+#endif
+
 /**
  * @brief   Calculates the unnormalized Internet Checksum of @p buf, where the
  *          buffer provides a slice of the full checksum domain, calculated in order.
@@ -73,6 +87,38 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates a checksum after a 16-bit word of its domain changed.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624#section-3">
+ *          RFC 1624, section 3
+ *      </a>
+ *
+ * @details Spares calculating the checksum again when forwarding or
+ *          rewriting headers. Call it once per word for larger fields.
+ *          Unlike the other functions, this one works on the checksum as
+ *          it is stored in a header, i.e. its 1's complement was taken.
+ *
+ * @param[in] csum      The checksum in host byte order.
+ * @param[in] old_word  The old value of the word in host byte order.
+ * @param[in] new_word  The new value of the word in host byte order.
+ *
+ * @return  The updated checksum in host byte order.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_word,
+                                          uint16_t new_word)
+{
+    /* HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    sum += (uint16_t)~old_word;
+    sum += new_word;
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+
+    return (uint16_t)~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -240,6 +240,27 @@ typedef enum {
      */
     NETOPT_RF_TESTMODE,
 
+    /**
+     * @brief   Device completes the checksums of frames it sends
+     *
+     * Get as type @ref netopt_enable_t. If enabled, the device fills in the
+     * UDP and ICMPv6 checksum of IPv6 packets whose upper layer header
+     * directly follows the IPv6 header, so the network stack does not need to
+     * calculate it. The stack leaves the checksum field of such packets zero,
+     * packets with any other value there are sent unchanged.
+     */
+    NETOPT_CSUM_OFFLOAD_TX,
+
+    /**
+     * @brief   Device verifies the checksums of frames it receives
+     *
+     * Get as type @ref netopt_enable_t. If enabled, the device tells the
+     * network stack per frame if it already verified the UDP or ICMPv6
+     * checksum of an IPv6 packet whose upper layer header directly follows
+     * the IPv6 header (see e.g. @ref NETDEV2_ETH_RX_CSUM_VALID).
+     */
+    NETOPT_CSUM_OFFLOAD_RX,
+
     /* add more options if needed */
 
     /**
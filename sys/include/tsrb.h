@@ -128,6 +128,25 @@ int tsrb_get_one(tsrb_t *rb);
  */
 int tsrb_get(tsrb_t *rb, char *dst, size_t n);
 
+/**
+ * @brief       Get the oldest contiguous bytes of the ringbuffer
+ *
+ * Lets the consumer read directly from the ringbuffer: process at most the
+ * returned number of bytes at @p span, then call tsrb_drop().
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    start of the oldest byte
+ * @return      nr of bytes that can be read from @p span
+ */
+size_t tsrb_get_span(tsrb_t *rb, char **span);
+
+/**
+ * @brief       Remove bytes from ringbuffer
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to remove, must not exceed tsrb_avail()
+ */
+void tsrb_drop(tsrb_t *rb, size_t n);
+
 /**
  * @brief       Add a byte to ringbuffer
  * @param[in]   rb  Ringbuffer to operate on
@@ -146,6 +165,28 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get the contiguous free space of the ringbuffer
+ *
+ * Lets the producer write directly into the ringbuffer: write at most the
+ * returned number of bytes to @p span, then call tsrb_commit(). If the free
+ * space wraps around the end of the buffer, the second part is returned
+ * after the first one was committed.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  span    start of the free space
+ * @return      nr of bytes that can be written to @p span
+ */
+size_t tsrb_peek_span(tsrb_t *rb, char **span);
+
+/**
+ * @brief       Add bytes written to the span returned by tsrb_peek_span()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, must not exceed the value returned
+ *                  by tsrb_peek_span()
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,6 +60,8 @@ typedef struct {
     uint8_t use_count;                       /**< The number of entries link here */
     uint8_t address_size;                    /**< Size in bytes of the used generic address */
     uint8_t address[UNIVERSAL_ADDRESS_SIZE]; /**< The generic address data */
+    uint16_t next;                           /**< Next container in the same hash
+                                                  bucket or the free list, internal */
 } universal_address_container_t;
 
 /**
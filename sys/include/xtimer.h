@@ -20,6 +20,18 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * If the (pseudo) module `xtimer_wheel` is used, timers are kept in a
+ * hierarchical timing wheel instead, which makes insertion and removal O(1).
+ * It has @ref XTIMER_WHEEL_LEVELS levels of 2^@ref XTIMER_WHEEL_BITS slots,
+ * each level's slots spanning all slots of the level below. The first level
+ * has a resolution of 1us, so timers fire as precisely as with the lists.
+ * Timers are moved down a level when the time reaches their slot, so each
+ * timer is touched at most once per level. Timers further away than the
+ * wheel spans are kept in an unsorted list that is rechecked whenever the
+ * time enters the next span of the wheel. The wheel costs
+ * XTIMER_WHEEL_LEVELS * 2^XTIMER_WHEEL_BITS pointers of RAM and one more
+ * pointer per xtimer_t.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -50,6 +62,10 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;        /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    struct xtimer **prev_next;  /**< reference to the pointer pointing to this
+                                     timer, used by the xtimer_wheel backend */
+#endif
     uint32_t target;            /**< lower 32bit absolute target time */
     uint32_t long_target;       /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
@@ -74,6 +90,20 @@ static inline uint32_t xtimer_now(void);
  */
 uint64_t xtimer_now64(void);
 
+/**
+ * @brief get a cached, coarse 64bit microsecond time
+ *
+ * Returns the time at which xtimer last handled a low-level timer
+ * interrupt, without reading the timer. This is meant for callers that only
+ * need millisecond precision, e.g., for lifetimes.
+ *
+ * The value lags xtimer_now64() by the time since the last xtimer interrupt.
+ * Set XTIMER_COARSE_TICK to bound that lag.
+ *
+ * @return  coarse current time as 64bit microsecond value
+ */
+uint64_t xtimer_now64_coarse(void);
+
 /**
  * @brief get the current system time into a timex_t
  *
@@ -247,15 +277,75 @@ void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
  */
 void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer that may fire up to @p slack microseconds late
+ *
+ * Like xtimer_set(), but the timer fires somewhere between @p offset and
+ * @p offset + @p slack microseconds from now. Within that window the target
+ * is rounded to the coarsest time that fits, so timers with overlapping
+ * windows tend to end up on the same target and are fired by the same
+ * low-level timer interrupt.
+ *
+ * Use this for timeouts that do not need to be precise, e.g., protocol
+ * timers tolerating some milliseconds of error.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    minimal time in microseconds from now specifying that
+ *                      timer's callback's execution time
+ * @param[in] slack     time in microseconds the timer may fire late
+ */
+void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
+
+/**
+ * @brief Set a timer that sends a message and may fire up to @p slack
+ *        microseconds late
+ *
+ * See xtimer_set_slack() and xtimer_set_msg().
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use.
+ * @param[in] offset        minimal microseconds from now
+ * @param[in] slack         microseconds the message may be sent late
+ * @param[in] msg           ptr to msg that will be sent
+ * @param[in] target_pid    pid the message will be sent to
+ */
+void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset, uint32_t slack,
+                          msg_t *msg, kernel_pid_t target_pid);
+
 /**
  * @brief remove a timer
  *
- * @note this function runs in O(n) with n being the number of active timers
+ * @note this function runs in O(n) with n being the number of active timers,
+ *       O(1) with the `xtimer_wheel` module
  *
  * @param[in] timer ptr to timer structure that will be removed
  */
 void xtimer_remove(xtimer_t *timer);
 
+#if defined(MODULE_XTIMER_STATS) || defined(DOXYGEN)
+/**
+ * @brief   xtimer statistics, available with the `xtimer_stats` module
+ *
+ * Timers that are fired by the same low-level timer interrupt as another
+ * timer save one wakeup each, i.e., @ref xtimer_stats_t::fired -
+ * @ref xtimer_stats_t::wakeups wakeups were saved.
+ */
+typedef struct {
+    uint32_t fired;         /**< timers fired from the timer interrupt */
+    uint32_t wakeups;       /**< timer interrupts that fired any timer */
+    uint32_t slack_set;     /**< timers set with xtimer_set_slack() */
+    uint32_t slack_moved;   /**< ... of which the target was moved */
+} xtimer_stats_t;
+
+/**
+ * @brief   xtimer statistics
+ */
+extern xtimer_stats_t xtimer_stats;
+#endif
+
 /**
  * @brief receive a message blocking but with timeout
  *
@@ -348,6 +438,36 @@ int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t us);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_COARSE_TICK
+/**
+ * @brief   Interval in microseconds of a periodic xtimer that keeps
+ *          xtimer_now64_coarse() up to date
+ *
+ * The default of 0 disables the periodic timer, so the coarse time is only
+ * updated when xtimer fires for some other reason. Set it to e.g. 1000 for
+ * millisecond precision, at the cost of as many extra wakeups.
+ */
+#define XTIMER_COARSE_TICK (0)
+#endif
+
+#ifndef XTIMER_WHEEL_BITS
+/**
+ * @brief   log2 of the number of slots per level of the `xtimer_wheel`
+ *
+ * Must not be larger than 4.
+ */
+#define XTIMER_WHEEL_BITS (4)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the `xtimer_wheel`
+ *
+ * The wheel spans 2^(XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_BITS) microseconds.
+ */
+#define XTIMER_WHEEL_LEVELS (8)
+#endif
+
 #ifndef XTIMER_SHIFT
 /**
  * @brief   xtimer prescaler value
@@ -74,6 +74,8 @@ static inline uint32_t _xtimer_lltimer_mask(uint32_t val)
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
 void _xtimer_sleep(uint32_t offset, uint32_t long_offset);
+void _xtimer_coarse_init(void);
+void _xtimer_coarse_update(uint64_t now);
 /** @} */
 
 #ifndef XTIMER_MIN_SPIN
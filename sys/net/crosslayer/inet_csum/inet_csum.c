@@ -13,13 +13,167 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
+#include <string.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
+#if INET_CSUM_SSE2
+#include <emmintrin.h>
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/*
+ * The buffer is summed up in words of the natural size of the platform in
+ * host byte order and the result is swapped to network byte order at the
+ * end, which yields the same one's complement sum
+ * (see https://tools.ietf.org/html/rfc1071#section-2, (B) and (C)).
+ */
+
+#if UINT_MAX > 0xffff
+typedef uint32_t _word_t;
+typedef uint64_t _acc_t;
+#else
+/* a 64-bit accumulator costs more than it saves on 8- and 16-bit platforms */
+typedef uint16_t _word_t;
+typedef uint32_t _acc_t;
+#endif
+
+#define WORD_SIZE   (sizeof(_word_t))
+#define UNROLL      (8U)
+
+static inline _word_t _load(const uint8_t *buf)
+{
+    _word_t word;
+
+    /* buf is aligned, so this compiles to a single load */
+    memcpy(&word, buf, sizeof(word));
+    return word;
+}
+
+static inline uint16_t _fold(_acc_t acc)
+{
+#if UINT_MAX > 0xffff
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+#endif
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return (uint16_t)acc;
+}
+
+#if INET_CSUM_SSE2
+/* sums 32 byte blocks of a 16 byte aligned buffer, returns the number of
+ * bytes summed */
+static size_t _sum_sse2(_acc_t *acc, const uint8_t *buf, size_t len)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i a = zero, b = zero;
+    uint32_t lanes[4];
+    size_t done;
+
+    /* lanes of 32 bit do not overflow, len is less than 2^16 */
+    for (done = 0; (len - done) >= 32; done += 32) {
+        __m128i x = _mm_load_si128((const __m128i *)(buf + done));
+        __m128i y = _mm_load_si128((const __m128i *)(buf + done + 16));
+
+        /* the two adds of each block are independent of each other */
+        a = _mm_add_epi32(a, _mm_unpacklo_epi16(x, zero));
+        b = _mm_add_epi32(b, _mm_unpackhi_epi16(x, zero));
+        a = _mm_add_epi32(a, _mm_unpacklo_epi16(y, zero));
+        b = _mm_add_epi32(b, _mm_unpackhi_epi16(y, zero));
+    }
+    _mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(a, b));
+    for (unsigned i = 0; i < 4; i++) {
+        *acc += lanes[i];
+    }
+
+    return done;
+}
+#endif
+
+/* one's complement sum of buf in host byte order, buf must be 16-bit aligned,
+ * a trailing byte is padded with zero */
+static uint16_t _sum_aligned(const uint8_t *buf, size_t len)
+{
+    _acc_t acc = 0;
+
+#if INET_CSUM_SSE2
+    while ((((uintptr_t)buf) & 0xf) && (len >= sizeof(uint16_t))) {
+        uint16_t word;
+
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+    if (len >= 32) {
+        size_t done = _sum_sse2(&acc, buf, len);
+
+        buf += done;
+        len -= done;
+    }
+#else
+    while ((((uintptr_t)buf) & (WORD_SIZE - 1)) && (len >= sizeof(uint16_t))) {
+        uint16_t word;
+
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+#endif
+
+    for (; len >= (UNROLL * WORD_SIZE); buf += UNROLL * WORD_SIZE,
+         len -= UNROLL * WORD_SIZE) {
+        acc += _load(buf);
+        acc += _load(buf + WORD_SIZE);
+        acc += _load(buf + (2 * WORD_SIZE));
+        acc += _load(buf + (3 * WORD_SIZE));
+        acc += _load(buf + (4 * WORD_SIZE));
+        acc += _load(buf + (5 * WORD_SIZE));
+        acc += _load(buf + (6 * WORD_SIZE));
+        acc += _load(buf + (7 * WORD_SIZE));
+    }
+    for (; len >= WORD_SIZE; buf += WORD_SIZE, len -= WORD_SIZE) {
+        acc += _load(buf);
+    }
+    for (; len >= sizeof(uint16_t); buf += sizeof(uint16_t), len -= sizeof(uint16_t)) {
+        uint16_t word;
+
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+    }
+    if (len > 0) {
+        uint16_t word = 0;
+
+        memcpy(&word, buf, 1);
+        acc += word;
+    }
+
+    return _fold(acc);
+}
+
+/* one's complement sum of buf in network byte order, a trailing byte is
+ * padded as upper half of a 16-bit word */
+static uint16_t _sum(const uint8_t *buf, size_t len)
+{
+    if (((uintptr_t)buf) & 1) {
+        /* the rest is aligned again, the sum of its words in the original
+         * alignment is its own sum with the bytes swapped */
+        uint32_t sum = byteorder_swaps(_sum(buf + 1, len - 1));
+
+        sum += (uint16_t)(*buf << 8);
+        return (uint16_t)((sum & 0xffff) + (sum >> 16));
+    }
+
+    return NTOHS(_sum_aligned(buf, len));
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -44,14 +198,10 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len > 0) {
+        csum += _sum(buf, len);
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
         csum = (csum & 0xffff) + carry;
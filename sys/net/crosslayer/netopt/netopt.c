@@ -58,6 +58,8 @@ static const char *_netopt_strmap[] = {
     [NETOPT_ENCRYPTION]      = "NETOPT_ENCRYPTION",
     [NETOPT_ENCRYPTION_KEY]  = "NETOPT_ENCRYPTION_KEY",
     [NETOPT_RF_TESTMODE]     = "NETOPT_RF_TESTMODE",
+    [NETOPT_CSUM_OFFLOAD_TX] = "NETOPT_CSUM_OFFLOAD_TX",
+    [NETOPT_CSUM_OFFLOAD_RX] = "NETOPT_CSUM_OFFLOAD_RX",
     [NETOPT_NUMOF]           = "NETOPT_NUMOF",
 };
 
@@ -38,6 +38,7 @@
 #endif
 
 #define NETDEV2_NETAPI_MSG_QUEUE_SIZE 8
+#define NETDEV2_NETAPI_MSG_BURST_SIZE 4
 
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
 
@@ -51,14 +52,9 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t*) dev->context;
 
     if (event == NETDEV2_EVENT_ISR) {
-        msg_t msg;
-
-        msg.type = NETDEV2_MSG_TYPE_EVENT;
-        msg.content.ptr = gnrc_netdev2;
-
-        if (msg_send(&msg, gnrc_netdev2->pid) <= 0) {
-            puts("gnrc_netdev2: possibly lost interrupt.");
-        }
+        /* an event can always be posted, multiple interrupts before the
+         * thread gets to handle them are coalesced into one isr() call */
+        event_post(&gnrc_netdev2->evq, &gnrc_netdev2->event_isr);
     }
     else {
         DEBUG("gnrc_netdev2: event triggered -> %i\n", event);
@@ -87,6 +83,15 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     }
 }
 
+static void _isr_handler(event_t *event)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = container_of(event, gnrc_netdev2_t, event_isr);
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    DEBUG("gnrc_netdev2: ISR event received\n");
+    dev->driver->isr(dev);
+}
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -97,6 +102,57 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+/**
+ * @brief   Handle a NETAPI message sent to the gnrc_netdev2 layer
+ *
+ * @param[in] gnrc_netdev2  the adapter the message was sent to
+ * @param[in] msg           the message to handle
+ */
+static void _handle_netapi_msg(gnrc_netdev2_t *gnrc_netdev2, msg_t *msg)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    gnrc_netapi_opt_t *opt;
+    msg_t reply;
+    int res;
+
+    switch (msg->type) {
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
+            gnrc_pktsnip_t *pkt = msg->content.ptr;
+            gnrc_netdev2->send(gnrc_netdev2, pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SET:
+            /* read incoming options */
+            opt = msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
+                    netopt2str(opt->opt));
+            /* set option for device driver */
+            res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_GET:
+            /* read incoming options */
+            opt = msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
+                    netopt2str(opt->opt));
+            /* get option from device driver */
+            res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        default:
+            DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg->type);
+            break;
+    }
+}
+
 /**
  * @brief   Startup code and event loop of the gnrc_netdev2 layer
  *
@@ -113,13 +169,16 @@ static void *_gnrc_netdev2_thread(void *args)
 
     gnrc_netdev2->pid = thread_getpid();
 
-    gnrc_netapi_opt_t *opt;
-    int res;
-    msg_t msg, reply, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
+    msg_t msgs[NETDEV2_NETAPI_MSG_BURST_SIZE], msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
 
     /* setup the MAC layers message queue */
     msg_init_queue(msg_queue, NETDEV2_NETAPI_MSG_QUEUE_SIZE);
 
+    /* setup the event queue for device interrupts */
+    event_queue_init(&gnrc_netdev2->evq);
+    gnrc_netdev2->event_isr.list_node.next = NULL;
+    gnrc_netdev2->event_isr.handler = _isr_handler;
+
     /* register the event callback with the device driver */
     dev->event_callback = _event_cb;
     dev->context = (void*) gnrc_netdev2;
@@ -132,48 +191,28 @@ static void *_gnrc_netdev2_thread(void *args)
 
     /* start the event loop */
     while (1) {
-        DEBUG("gnrc_netdev2: waiting for incoming messages\n");
-        msg_receive(&msg);
-        /* dispatch NETDEV and NETAPI messages */
-        switch (msg.type) {
-            case NETDEV2_MSG_TYPE_EVENT:
-                DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                gnrc_pktsnip_t *pkt = msg.content.ptr;
-                gnrc_netdev2->send(gnrc_netdev2, pkt);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                /* read incoming options */
-                opt = msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* set option for device driver */
-                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                /* read incoming options */
-                opt = msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* get option from device driver */
-                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg.type);
-                break;
+        DEBUG("gnrc_netdev2: waiting for incoming events and messages\n");
+        thread_flags_t flags = thread_flags_wait_any(THREAD_FLAG_EVENT |
+                                                     THREAD_FLAG_MSG_WAITING);
+
+        /* dispatch NETDEV events */
+        if (flags & THREAD_FLAG_EVENT) {
+            event_t *event;
+
+            while ((event = event_get(&gnrc_netdev2->evq))) {
+                event->handler(event);
+            }
+        }
+
+        /* dispatch NETAPI messages */
+        if (flags & THREAD_FLAG_MSG_WAITING) {
+            unsigned num;
+
+            while ((num = msg_try_receive_bulk(msgs, NETDEV2_NETAPI_MSG_BURST_SIZE))) {
+                for (unsigned i = 0; i < num; i++) {
+                    _handle_netapi_msg(gnrc_netdev2, &msgs[i]);
+                }
+            }
         }
     }
     /* never reached */
@@ -19,6 +19,7 @@
 #include "net/gnrc.h"
 #include "net/gnrc/netdev2.h"
 #include "net/ethernet/hdr.h"
+#include "net/netdev2/eth.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
@@ -32,6 +33,7 @@
 static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
 {
     netdev2_t *dev = gnrc_netdev2->dev;
+    netdev2_eth_rx_info_t rx_info = { .flags = 0 };
     int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
     gnrc_pktsnip_t *pkt = NULL;
 
@@ -49,7 +51,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, &rx_info);
         if(nread <= 0) {
             DEBUG("_recv_ethernet_packet: read error.\n");
             goto safe_out;
@@ -91,6 +93,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
         gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
         ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = thread_getpid();
+        if (rx_info.flags & NETDEV2_ETH_RX_CSUM_VALID) {
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM_VALID;
+        }
 
         DEBUG("gnrc_netdev2_eth: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
                 "of length %d\n",
@@ -26,13 +26,29 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+#if (GNRC_NETREG_BUCKETS & (GNRC_NETREG_BUCKETS - 1)) != 0
+#error "GNRC_NETREG_BUCKETS must be a power of 2"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t, hashed by demux context.
+ * All entries with the same demux context are in the same bucket, so
+ * gnrc_netreg_getnext() can just continue in that bucket. */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+    /* fold all bytes into the low bits, as contexts are ports and protocol
+     * numbers as well as GNRC_NETREG_DEMUX_CTX_ALL */
+    demux_ctx ^= demux_ctx >> 16;
+    demux_ctx ^= demux_ctx >> 8;
+    return &netreg[type][demux_ctx & (GNRC_NETREG_BUCKETS - 1)];
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -52,7 +68,7 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    LL_PREPEND(*_bucket(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -63,7 +79,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_bucket(type, entry->demux_ctx), entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -74,7 +90,7 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    LL_SEARCH_SCALAR(*_bucket(type, demux_ctx), res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -88,7 +104,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = *_bucket(type, demux_ctx);
 
     while (entry != NULL) {
         if (entry->demux_ctx == demux_ctx) {
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+
+#include "net/gnrc/ipv6/dcache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_IPV6_DCACHE_SIZE & (GNRC_IPV6_DCACHE_SIZE - 1)) != 0
+#error "GNRC_IPV6_DCACHE_SIZE must be a power of 2"
+#endif
+
+#if ENABLE_DEBUG
+static char addr_str[IPV6_ADDR_MAX_STR_LEN];
+#endif
+
+static gnrc_ipv6_dcache_t _dcache[GNRC_IPV6_DCACHE_SIZE];
+/* entries are valid as long as their generation is the current one, so a
+ * flush is a single increment that is safe to do from any thread. Starts at 1
+ * so the zeroed entries are invalid. */
+static volatile uint32_t _gen = 1;
+/* state at the last miss, used by gnrc_ipv6_dcache_add() */
+static uint32_t _miss_gen;
+#ifdef MODULE_FIB
+static uint32_t _miss_fib_version;
+#endif
+static gnrc_ipv6_dcache_stats_t _stats;
+
+static inline gnrc_ipv6_dcache_t *_entry(const ipv6_addr_t *dst)
+{
+    /* unicast destinations mostly differ in the interface identifier */
+    uint32_t hash = dst->u32[2].u32 ^ dst->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash *= 0x9e3779b1;
+    hash ^= hash >> 16;
+
+    return &_dcache[hash & (GNRC_IPV6_DCACHE_SIZE - 1)];
+}
+
+static inline bool _valid(const gnrc_ipv6_dcache_t *entry)
+{
+#ifdef MODULE_FIB
+    if (entry->fib_version != gnrc_ipv6_fib_table.version) {
+        return false;
+    }
+#endif
+    return (entry->gen == _gen);
+}
+
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_get(kernel_pid_t iface, const ipv6_addr_t *dst)
+{
+    gnrc_ipv6_dcache_t *entry = _entry(dst);
+
+    if (_valid(entry) && (entry->req_iface == iface) && ipv6_addr_equal(&entry->dst, dst)) {
+        _stats.hits++;
+        return entry;
+    }
+
+    _stats.misses++;
+    _miss_gen = _gen;
+#ifdef MODULE_FIB
+    _miss_fib_version = gnrc_ipv6_fib_table.version;
+#endif
+    return NULL;
+}
+
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_add(kernel_pid_t req_iface, const ipv6_addr_t *dst,
+                                         kernel_pid_t iface, const uint8_t *l2addr,
+                                         uint8_t l2addr_len)
+{
+    gnrc_ipv6_dcache_t *entry = _entry(dst);
+    gnrc_ipv6_netif_t *netif = gnrc_ipv6_netif_get(iface);
+    ipv6_addr_t *src;
+
+    if ((l2addr_len > GNRC_IPV6_NC_L2_ADDR_MAX) || (netif == NULL)) {
+        return NULL;
+    }
+
+    src = gnrc_ipv6_netif_find_best_src_addr(iface, dst, false);
+    if (src != NULL) {
+        memcpy(&entry->src, src, sizeof(ipv6_addr_t));
+    }
+    else {
+        ipv6_addr_set_unspecified(&entry->src);
+    }
+    memcpy(&entry->dst, dst, sizeof(ipv6_addr_t));
+    memcpy(entry->l2addr, l2addr, l2addr_len);
+    entry->l2addr_len = l2addr_len;
+    entry->req_iface = req_iface;
+    entry->iface = iface;
+    entry->mtu = netif->mtu;
+    entry->gen = _miss_gen;
+#ifdef MODULE_FIB
+    entry->fib_version = _miss_fib_version;
+#endif
+
+    DEBUG("ipv6 dcache: added %s", ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    DEBUG(" => %s\n", gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                             l2addr, l2addr_len));
+
+    return entry;
+}
+
+void gnrc_ipv6_dcache_flush(void)
+{
+    _gen++;
+    _stats.flushes++;
+}
+
+gnrc_ipv6_dcache_t *gnrc_ipv6_dcache_get_next(gnrc_ipv6_dcache_t *prev)
+{
+    gnrc_ipv6_dcache_t *entry = (prev == NULL) ? _dcache : (prev + 1);
+
+    for (; entry < (_dcache + GNRC_IPV6_DCACHE_SIZE); entry++) {
+        if (_valid(entry)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+void gnrc_ipv6_dcache_get_stats(gnrc_ipv6_dcache_stats_t *stats)
+{
+    memcpy(stats, &_stats, sizeof(gnrc_ipv6_dcache_stats_t));
+}
+
+/** @} */
@@ -26,9 +26,11 @@
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc/sixlowpan/nd/router.h"
 #include "net/protnum.h"
+#include "net/udp.h"
 #include "thread.h"
 #include "utlist.h"
 
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
@@ -92,6 +94,7 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
     fib_init(&gnrc_ipv6_fib_table);
+    fib_set_expiry_thread(&gnrc_ipv6_fib_table, gnrc_ipv6_pid);
 #endif
 
     return gnrc_ipv6_pid;
@@ -250,7 +253,8 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
 
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    msg_t msgs[GNRC_IPV6_MSG_BURST_SIZE], reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    unsigned num = 0, pos = 0;
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -265,31 +269,42 @@ static void *_event_loop(void *args)
 
     /* start event loop */
     while (1) {
-        DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
+        if (pos == num) {
+            DEBUG("ipv6: waiting for incoming messages.\n");
+            num = msg_receive_bulk(msgs, GNRC_IPV6_MSG_BURST_SIZE);
+            pos = 0;
+        }
+        msg_t *msg = &msgs[pos++];
 
-        switch (msg.type) {
+        switch (msg->type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
+                _receive(msg->content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr, true);
+                _send(msg->content.ptr, true);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
+                msg_reply(msg, &reply);
+                break;
+
+#ifdef MODULE_FIB
+            case FIB_MSG_EXPIRE:
+                DEBUG("ipv6: FIB expiry received\n");
+                fib_expire(msg->content.ptr);
                 break;
+#endif
 
 #ifdef MODULE_GNRC_NDP
             case GNRC_NDP_MSG_RTR_TIMEOUT:
                 DEBUG("ipv6: Router timeout received\n");
-                ((gnrc_ipv6_nc_t *)msg.content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                ((gnrc_ipv6_nc_t *)msg->content.ptr)->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
                 break;
 
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
@@ -297,48 +312,48 @@ static void *_event_loop(void *args)
             /* case GNRC_NDP_MSG_ADDR_TIMEOUT: */
             /*     DEBUG("ipv6: Router advertisement timer event received\n"); */
             /*     gnrc_ipv6_netif_remove_addr(KERNEL_PID_UNDEF, */
-            /*                                 msg.content.ptr); */
+            /*                                 msg->content.ptr); */
             /*     break; */
 
             case GNRC_NDP_MSG_NBR_SOL_RETRANS:
                 DEBUG("ipv6: Neigbor solicitation retransmission timer event received\n");
-                gnrc_ndp_retrans_nbr_sol(msg.content.ptr);
+                gnrc_ndp_retrans_nbr_sol(msg->content.ptr);
                 break;
 
             case GNRC_NDP_MSG_NC_STATE_TIMEOUT:
                 DEBUG("ipv6: Neigbor cache state timeout received\n");
-                gnrc_ndp_state_timeout(msg.content.ptr);
+                gnrc_ndp_state_timeout(msg->content.ptr);
                 break;
 #endif
 #ifdef MODULE_GNRC_NDP_ROUTER
             case GNRC_NDP_MSG_RTR_ADV_RETRANS:
                 DEBUG("ipv6: Router advertisement retransmission event received\n");
-                gnrc_ndp_router_retrans_rtr_adv(msg.content.ptr);
+                gnrc_ndp_router_retrans_rtr_adv(msg->content.ptr);
                 break;
             case GNRC_NDP_MSG_RTR_ADV_DELAY:
                 DEBUG("ipv6: Delayed router advertisement event received\n");
-                gnrc_ndp_router_send_rtr_adv(msg.content.ptr);
+                gnrc_ndp_router_send_rtr_adv(msg->content.ptr);
                 break;
 #endif
 #ifdef MODULE_GNRC_NDP_HOST
             case GNRC_NDP_MSG_RTR_SOL_RETRANS:
                 DEBUG("ipv6: Router solicitation retransmission event received\n");
-                gnrc_ndp_host_retrans_rtr_sol(msg.content.ptr);
+                gnrc_ndp_host_retrans_rtr_sol(msg->content.ptr);
                 break;
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
             case GNRC_SIXLOWPAN_ND_MSG_MC_RTR_SOL:
                 DEBUG("ipv6: Multicast router solicitation event received\n");
-                gnrc_sixlowpan_nd_mc_rtr_sol(msg.content.ptr);
+                gnrc_sixlowpan_nd_mc_rtr_sol(msg->content.ptr);
                 break;
             case GNRC_SIXLOWPAN_ND_MSG_UC_RTR_SOL:
                 DEBUG("ipv6: Unicast router solicitation event received\n");
-                gnrc_sixlowpan_nd_uc_rtr_sol(msg.content.ptr);
+                gnrc_sixlowpan_nd_uc_rtr_sol(msg->content.ptr);
                 break;
 #   ifdef MODULE_GNRC_SIXLOWPAN_CTX
             case GNRC_SIXLOWPAN_ND_MSG_DELETE_CTX:
                 DEBUG("ipv6: Delete 6LoWPAN context event received\n");
-                gnrc_sixlowpan_ctx_remove(((((gnrc_sixlowpan_ctx_t *)msg.content.ptr)->flags_id) &
+                gnrc_sixlowpan_ctx_remove(((((gnrc_sixlowpan_ctx_t *)msg->content.ptr)->flags_id) &
                                            GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK));
                 break;
 #   endif
@@ -346,17 +361,17 @@ static void *_event_loop(void *args)
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
             case GNRC_SIXLOWPAN_ND_MSG_ABR_TIMEOUT:
                 DEBUG("ipv6: border router timeout event received\n");
-                gnrc_sixlowpan_nd_router_abr_remove(msg.content.ptr);
+                gnrc_sixlowpan_nd_router_abr_remove(msg->content.ptr);
                 break;
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
              * solved properly */
             /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
             /*     DEBUG("ipv6: address registration timeout received\n"); */
-            /*     gnrc_sixlowpan_nd_router_gc_nc(msg.content.ptr); */
+            /*     gnrc_sixlowpan_nd_router_gc_nc(msg->content.ptr); */
             /*     break; */
             case GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY:
                 DEBUG("ipv6: Delayed router advertisement event received\n");
-                gnrc_ipv6_nc_t *nc_entry = msg.content.ptr;
+                gnrc_ipv6_nc_t *nc_entry = msg->content.ptr;
                 gnrc_ndp_internal_send_rtr_adv(nc_entry->iface, NULL,
                                                &(nc_entry->ipv6_addr), false);
                 break;
@@ -450,8 +465,25 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
     _send_to_iface(iface, pkt);
 }
 
+/* checks if iface fills in the checksum of the upper layer itself */
+static inline bool _csum_offloaded(kernel_pid_t iface, ipv6_hdr_t *hdr,
+                                   gnrc_pktsnip_t *payload)
+{
+    gnrc_ipv6_netif_t *netif;
+
+    /* only if the upper layer header directly follows the IPv6 header */
+    if ((iface == KERNEL_PID_UNDEF) || (payload == NULL) ||
+        ((hdr->nh != PROTNUM_UDP) && (hdr->nh != PROTNUM_ICMPV6)) ||
+        (gnrc_nettype_to_protnum(payload->type) != hdr->nh)) {
+        return false;
+    }
+    netif = gnrc_ipv6_netif_get(iface);
+
+    return (netif != NULL) && (netif->flags & GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD_TX);
+}
+
 static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
-                          gnrc_pktsnip_t *payload)
+                          gnrc_pktsnip_t *payload, bool loopback)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -497,6 +529,19 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
         }
     }
 
+    /* packets looped back never reach the interface */
+    if (!loopback && _csum_offloaded(iface, hdr, payload)) {
+        DEBUG("ipv6: leave checksum for upper header to interface.\n");
+        /* a zero checksum field tells the interface to fill it in */
+        if (hdr->nh == PROTNUM_UDP) {
+            ((udp_hdr_t *)payload->data)->checksum.u16 = 0;
+        }
+        else {
+            ((icmpv6_hdr_t *)payload->data)->csum.u16 = 0;
+        }
+        return 0;
+    }
+
     DEBUG("ipv6: calculate checksum for upper header.\n");
 
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
@@ -576,7 +621,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     ptr = ptr->next;
                 }
 
-                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
+                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp, false) < 0) {
                     /* error on filling up header */
                     gnrc_pktbuf_release(ipv6);
                     return;
@@ -592,7 +637,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
     else {
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload, false) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -613,7 +658,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
 
     if (prep_hdr) {
-        if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+        if (_fill_ipv6_hdr(iface, ipv6, payload, false) < 0) {
             /* error on filling up header */
             gnrc_pktbuf_release(pkt);
             return;
@@ -654,6 +699,35 @@ static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len
     return found_iface;
 }
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+static kernel_pid_t _next_hop_cached(uint8_t *l2addr, uint8_t *l2addr_len,
+                                     kernel_pid_t iface, ipv6_hdr_t *hdr,
+                                     bool prep_hdr, gnrc_pktsnip_t *pkt)
+{
+    gnrc_ipv6_dcache_t *entry = gnrc_ipv6_dcache_get(iface, &hdr->dst);
+    kernel_pid_t found_iface;
+
+    if (entry == NULL) {
+        found_iface = _next_hop_l2addr(l2addr, l2addr_len, iface, &hdr->dst, pkt);
+        if (found_iface > KERNEL_PID_UNDEF) {
+            gnrc_ipv6_dcache_add(iface, &hdr->dst, found_iface, l2addr, *l2addr_len);
+        }
+        return found_iface;
+    }
+
+    DEBUG("ipv6: next hop of %s found in destination cache\n",
+          ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)));
+    memcpy(l2addr, entry->l2addr, entry->l2addr_len);
+    *l2addr_len = entry->l2addr_len;
+    /* spare _fill_ipv6_hdr() the source address selection */
+    if (prep_hdr && ipv6_addr_is_unspecified(&hdr->src)) {
+        memcpy(&hdr->src, &entry->src, sizeof(ipv6_addr_t));
+    }
+
+    return entry->iface;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 {
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -710,7 +784,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt;
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload, true) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
@@ -747,7 +821,11 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+        iface = _next_hop_cached(l2addr, &l2addr_len, iface, hdr, prep_hdr, pkt);
+#else
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
+#endif
 
         if (iface == KERNEL_PID_UNDEF) {
             DEBUG("ipv6: error determining next hop's link layer address\n");
@@ -756,7 +834,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         }
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload, false) < 0) {
                 /* error on filling up header */
                 gnrc_pktbuf_release(pkt);
                 return;
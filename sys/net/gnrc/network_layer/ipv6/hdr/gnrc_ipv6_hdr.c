@@ -38,7 +38,7 @@ gnrc_pktsnip_t *gnrc_ipv6_hdr_build(gnrc_pktsnip_t *payload, const ipv6_addr_t *
     gnrc_pktsnip_t *ipv6;
     ipv6_hdr_t *hdr;
 
-    ipv6 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv6_hdr_t), HDR_NETTYPE);
+    ipv6 = gnrc_pktbuf_prepend(payload, sizeof(ipv6_hdr_t), HDR_NETTYPE);
 
     if (ipv6 == NULL) {
         DEBUG("ipv6_hdr: no space left in packet buffer\n");
@@ -16,6 +16,7 @@
 #include <string.h>
 
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -35,12 +36,106 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#if (GNRC_IPV6_NC_BUCKETS & (GNRC_IPV6_NC_BUCKETS - 1)) != 0
+#error "GNRC_IPV6_NC_BUCKETS must be a power of 2"
+#endif
+
+#if GNRC_IPV6_NC_SIZE >= UINT16_MAX
+#error "GNRC_IPV6_NC_SIZE must be less than 65535"
+#endif
+
+/* marks the end of a bucket, the free list or an empty LRU list */
+#define NC_NIL  (UINT16_MAX)
+
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
+/* first entry of every hash bucket, chained by gnrc_ipv6_nc_t::next */
+static uint16_t _buckets[GNRC_IPV6_NC_BUCKETS];
+/* first unused entry, chained by gnrc_ipv6_nc_t::next */
+static uint16_t _free = NC_NIL;
+/* most recently used entry of the circular LRU list, its
+ * gnrc_ipv6_nc_t::lru_prev is the least recently used one */
+static uint16_t _lru = NC_NIL;
+static uint32_t _evictions, _full;
+
+static inline uint16_t *_bucket(const ipv6_addr_t *ipv6_addr)
+{
+    uint32_t hash = ipv6_addr->u32[0].u32 ^ ipv6_addr->u32[1].u32;
+
+    /* neighbors mostly differ in the last bytes of the interface identifier,
+     * which end up in the upper bits of the word: fold them down before
+     * multiplying, so they reach the bucket index */
+    hash ^= ipv6_addr->u32[2].u32 ^ ipv6_addr->u32[3].u32;
+    hash ^= hash >> 16;
+    hash *= 0x9e3779b1;
+    hash ^= hash >> 16;
+
+    return &_buckets[hash & (GNRC_IPV6_NC_BUCKETS - 1)];
+}
+
+static inline bool _in_use(const gnrc_ipv6_nc_t *entry)
+{
+    return !ipv6_addr_is_unspecified(&(entry->ipv6_addr));
+}
+
+static void _lru_unlink(uint16_t idx)
+{
+    gnrc_ipv6_nc_t *entry = &ncache[idx];
+
+    if (entry->lru_next == idx) {
+        _lru = NC_NIL;
+        return;
+    }
+    ncache[entry->lru_prev].lru_next = entry->lru_next;
+    ncache[entry->lru_next].lru_prev = entry->lru_prev;
+    if (_lru == idx) {
+        _lru = entry->lru_next;
+    }
+}
+
+static void _lru_push(uint16_t idx)
+{
+    gnrc_ipv6_nc_t *entry = &ncache[idx];
+
+    if (_lru == NC_NIL) {
+        entry->lru_prev = idx;
+        entry->lru_next = idx;
+    }
+    else {
+        entry->lru_next = _lru;
+        entry->lru_prev = ncache[_lru].lru_prev;
+        ncache[entry->lru_prev].lru_next = idx;
+        ncache[_lru].lru_prev = idx;
+    }
+    _lru = idx;
+}
+
+static inline void _lru_touch(gnrc_ipv6_nc_t *entry)
+{
+    uint16_t idx = entry - ncache;
+
+    if (_lru != idx) {
+        _lru_unlink(idx);
+        _lru_push(idx);
+    }
+}
+
+static gnrc_ipv6_nc_t *_find(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
+{
+    for (uint16_t i = *_bucket(ipv6_addr); i != NC_NIL; i = ncache[i].next) {
+        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+             (iface == ncache[i].iface)) &&
+            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
+            return ncache + i;
+        }
+    }
+
+    return NULL;
+}
 
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
-    if (entry == NULL) {
+    if ((entry == NULL) || !_in_use(entry)) {
         return;
     }
 
@@ -73,9 +168,62 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     xtimer_remove(&entry->nbr_sol_timer);
     xtimer_remove(&entry->nbr_adv_timer);
 
+    /* unlink from the bucket and the LRU list and put it on the free list */
+    uint16_t idx = entry - ncache;
+    uint16_t *pos = _bucket(&(entry->ipv6_addr));
+
+    while (*pos != idx) {
+        pos = &ncache[*pos].next;
+    }
+    *pos = entry->next;
+    _lru_unlink(idx);
+    entry->next = _free;
+    _free = idx;
+
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    gnrc_ipv6_dcache_flush();
+#endif
+}
+
+/* entries that may be replaced by a new neighbor if the cache is full: no
+ * router or registered entry and nothing is going on for them */
+static inline bool _evictable(const gnrc_ipv6_nc_t *entry)
+{
+    uint8_t type = gnrc_ipv6_nc_get_type(entry);
+
+    switch (gnrc_ipv6_nc_get_state(entry)) {
+        case GNRC_IPV6_NC_STATE_STALE:
+        case GNRC_IPV6_NC_STATE_UNMANAGED:
+            return !(entry->flags & GNRC_IPV6_NC_IS_ROUTER) &&
+                   ((type == GNRC_IPV6_NC_TYPE_NONE) || (type == GNRC_IPV6_NC_TYPE_GC));
+
+        default:
+            return false;
+    }
+}
+
+/* removes the least recently used entry that may be evicted */
+static void _evict(void)
+{
+    if (_lru == NC_NIL) {
+        return;
+    }
+
+    uint16_t i = _lru;
+
+    do {
+        i = ncache[i].lru_prev;
+        if (_evictable(&ncache[i])) {
+            DEBUG("ipv6_nc: evict %s\n",
+                  ipv6_addr_to_str(addr_str, &(ncache[i].ipv6_addr), sizeof(addr_str)));
+            _nc_remove(ncache[i].iface, &ncache[i]);
+            _evictions++;
+            return;
+        }
+    } while (i != _lru);
 }
 
 void gnrc_ipv6_nc_init(void)
@@ -86,23 +234,26 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
-}
 
-gnrc_ipv6_nc_t *_find_free_entry(void)
-{
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr))) {
-            return ncache + i;
-        }
+    for (int i = 0; i < GNRC_IPV6_NC_BUCKETS; i++) {
+        _buckets[i] = NC_NIL;
     }
-
-    return NULL;
+    /* hand out entries in ascending order */
+    _free = NC_NIL;
+    for (int i = GNRC_IPV6_NC_SIZE - 1; i >= 0; i--) {
+        ncache[i].next = _free;
+        _free = i;
+    }
+    _lru = NC_NIL;
+    _evictions = 0;
+    _full = 0;
 }
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
     gnrc_ipv6_nc_t *free_entry = NULL;
+    uint16_t *bucket;
 
     if (ipv6_addr == NULL) {
         DEBUG("ipv6_nc: address was NULL\n");
@@ -114,38 +265,47 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
-
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
+    gnrc_ipv6_nc_t *entry = _find(KERNEL_PID_UNDEF, ipv6_addr);
 
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
+    if (entry != NULL) {
+        DEBUG("ipv6_nc: Address %s already registered.\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
 
-            }
-            return &ncache[i];
-        }
+        if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+            DEBUG("ipv6_nc: Update to L2 address %s",
+                  gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                         l2_addr, l2_addr_len));
+
+            memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+            entry->l2_addr_len = l2_addr_len;
+            entry->flags = flags;
+            DEBUG(" with flags = 0x%0x\n", flags);
+#ifdef MODULE_GNRC_IPV6_DCACHE
+            gnrc_ipv6_dcache_flush();
+#endif
 
-        if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
-            /* found the first free entry */
-            free_entry = &ncache[i];
         }
+        _lru_touch(entry);
+        return entry;
     }
 
-    if (!free_entry) {
-        /* reached end of NC without finding updateable or free entry */
+    if (_free == NC_NIL) {
+        _evict();
+    }
+    if (_free == NC_NIL) {
+        /* neither a free nor an evictable entry */
         DEBUG("ipv6_nc: neighbor cache full.\n");
+        _full++;
         return NULL;
     }
 
     /* Otherwise, fill free entry with your fresh information */
+    free_entry = &ncache[_free];
+    _free = free_entry->next;
+    bucket = _bucket(ipv6_addr);
+    free_entry->next = *bucket;
+    *bucket = free_entry - ncache;
+    _lru_push(free_entry - ncache);
     free_entry->iface = iface;
 
 #ifdef MODULE_GNRC_NDP_NODE
@@ -188,6 +348,12 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
 
     free_entry->nbr_sol_msg.content.ptr = free_entry;
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    /* the new neighbor may be the next hop for destinations resolved
+     * differently before */
+    gnrc_ipv6_dcache_flush();
+#endif
+
     return free_entry;
 }
 
@@ -199,25 +365,35 @@ void gnrc_ipv6_nc_remove(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr)
 {
+    gnrc_ipv6_nc_t *entry;
+
     if ((ipv6_addr == NULL) || (ipv6_addr_is_unspecified(ipv6_addr))) {
         DEBUG("ipv6_nc: address was NULL or ::\n");
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
-             (iface == ncache[i].iface)) &&
-            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
-                  " (0 = all interfaces) [%p]\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
-
-            return ncache + i;
-        }
+    entry = _find(iface, ipv6_addr);
+    if (entry != NULL) {
+        DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
+              " (0 = all interfaces) [%p]\n",
+              ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
+              iface, (void *)entry);
+        _lru_touch(entry);
     }
 
-    return NULL;
+    return entry;
+}
+
+void gnrc_ipv6_nc_get_stats(gnrc_ipv6_nc_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    for (gnrc_ipv6_nc_t *entry = gnrc_ipv6_nc_get_next(NULL); entry != NULL;
+         entry = gnrc_ipv6_nc_get_next(entry)) {
+        stats->states[gnrc_ipv6_nc_get_state(entry)]++;
+        stats->entries++;
+    }
+    stats->evictions = _evictions;
+    stats->full = _full;
 }
 
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_get_next(gnrc_ipv6_nc_t *prev)
@@ -25,6 +25,7 @@
 
 #include "net/eui64.h"
 #include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif.h"
@@ -165,6 +166,9 @@ static void _reset_addr_from_entry(gnrc_ipv6_netif_t *entry)
 {
     DEBUG("ipv6 netif: Reset IPv6 addresses on interface %" PRIkernel_pid "\n", entry->pid);
     memset(entry->addrs, 0, sizeof(entry->addrs));
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    gnrc_ipv6_dcache_flush();
+#endif
 }
 
 static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
@@ -309,6 +313,11 @@ ipv6_addr_t *gnrc_ipv6_netif_add_addr(kernel_pid_t pid, const ipv6_addr_t *addr,
 
     mutex_unlock(&entry->mutex);
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    /* source addresses and on-link prefixes may have changed */
+    gnrc_ipv6_dcache_flush();
+#endif
+
     return res;
 }
 
@@ -322,6 +331,9 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), entry->pid);
             ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
             entry->addrs[i].flags = 0;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+            gnrc_ipv6_dcache_flush();
+#endif
 #ifdef MODULE_GNRC_NDP_ROUTER
             /* Removal of prefixes MAY allow the router to retransmit up to
              * GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF unsolicited RA
@@ -799,6 +811,7 @@ void gnrc_ipv6_netif_init_by_dev(void)
         ipv6_addr_t addr;
         eui64_t iid;
         uint16_t tmp;
+        netopt_enable_t enable = NETOPT_DISABLE;
         gnrc_ipv6_netif_t *ipv6_if = gnrc_ipv6_netif_get(ifs[i]);
 
         if (ipv6_if == NULL) {
@@ -870,6 +883,14 @@ void gnrc_ipv6_netif_init_by_dev(void)
             ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_IS_WIRED;
         }
 
+        if ((gnrc_netapi_get(ifs[i], NETOPT_CSUM_OFFLOAD_TX, 0, &enable,
+                             sizeof(enable)) > 0) && (enable == NETOPT_ENABLE)) {
+            ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD_TX;
+        }
+        else {
+            ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD_TX;
+        }
+
         mutex_unlock(&ipv6_if->mutex);
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
         gnrc_ipv6_netif_set_router(ipv6_if, true);
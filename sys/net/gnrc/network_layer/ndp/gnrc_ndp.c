@@ -24,6 +24,7 @@
 #include "net/ipv6/ext/rh.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc.h"
 #include "net/sixlowpan/nd.h"
@@ -46,6 +47,26 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+/* sets or clears the isRouter flag of an entry, the default router and thus
+ * the next hop of off-link destinations may change with it */
+static void _set_is_router(gnrc_ipv6_nc_t *nc_entry, bool is_router)
+{
+    uint8_t flags = nc_entry->flags;
+
+    if (is_router) {
+        flags |= GNRC_IPV6_NC_IS_ROUTER;
+    }
+    else {
+        flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+    }
+    if (flags != nc_entry->flags) {
+        nc_entry->flags = flags;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+        gnrc_ipv6_dcache_flush();
+#endif
+    }
+}
+
 /* sets an entry to stale if its l2addr differs from the given one or creates it stale if it
  * does not exist */
 static void _stale_nc(kernel_pid_t iface, ipv6_addr_t *ipaddr, uint8_t *l2addr,
@@ -308,10 +329,10 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             }
 
             if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) {
-                nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
+                _set_is_router(nc_entry, true);
             }
             else {
-                nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                _set_is_router(nc_entry, false);
                 /* TODO: update state of neighbor as router in FIB? */
             }
 #ifdef MODULE_GNRC_NDP_NODE
@@ -356,10 +377,10 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 }
 
                 if (nbr_adv->flags & NDP_NBR_ADV_FLAGS_R) {
-                    nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
+                    _set_is_router(nc_entry, true);
                 }
                 else {
-                    nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+                    _set_is_router(nc_entry, false);
                     /* TODO: update state of neighbor as router in FIB? */
                 }
             }
@@ -471,7 +492,7 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
         if (nc_entry != NULL) {
             /* unset isRouter flag
              * (https://tools.ietf.org/html/rfc4861#section-6.2.6) */
-            nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+            _set_is_router(nc_entry, false);
         }
     }
     /* otherwise ignore silently */
@@ -522,10 +543,10 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
         }
     }
     else if ((nc_entry->flags & GNRC_IPV6_NC_IS_ROUTER) && (byteorder_ntohs(rtr_adv->ltime) == 0)) {
-        nc_entry->flags &= ~GNRC_IPV6_NC_IS_ROUTER;
+        _set_is_router(nc_entry, false);
     }
     else {
-        nc_entry->flags |= GNRC_IPV6_NC_IS_ROUTER;
+        _set_is_router(nc_entry, true);
     }
     /* set router life timer */
     if (rtr_adv->ltime.u16 != 0) {
@@ -16,6 +16,7 @@
 
 #include "net/eui64.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -95,6 +96,11 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
 
     nc_entry->flags &= ~GNRC_IPV6_NC_STATE_MASK;
     nc_entry->flags |= state;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    /* next hops cached for this neighbor must run through neighbor
+     * unreachability detection again */
+    gnrc_ipv6_dcache_flush();
+#endif
 
     DEBUG("ndp internal: set %s state to ",
           ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
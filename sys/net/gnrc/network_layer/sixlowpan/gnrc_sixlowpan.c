@@ -309,7 +309,8 @@ static void _send(gnrc_pktsnip_t *pkt)
 
 static void *_event_loop(void *args)
 {
-    msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+    msg_t msgs[GNRC_SIXLOWPAN_MSG_BURST_SIZE], reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+    unsigned num = 0, pos = 0;
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -324,30 +325,34 @@ static void *_event_loop(void *args)
 
     /* start event loop */
     while (1) {
-        DEBUG("6lo: waiting for incoming message.\n");
-        msg_receive(&msg);
+        if (pos == num) {
+            DEBUG("6lo: waiting for incoming messages.\n");
+            num = msg_receive_bulk(msgs, GNRC_SIXLOWPAN_MSG_BURST_SIZE);
+            pos = 0;
+        }
+        msg_t *msg = &msgs[pos++];
 
-        switch (msg.type) {
+        switch (msg->type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_RCV received\n");
-                _receive(msg.content.ptr);
+                _receive(msg->content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("6lo: GNRC_NETDEV_MSG_TYPE_SND received\n");
-                _send(msg.content.ptr);
+                _send(msg->content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
-                msg_reply(&msg, &reply);
+                msg_reply(msg, &reply);
                 break;
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
             case GNRC_SIXLOWPAN_MSG_FRAG_SND:
                 DEBUG("6lo: send fragmented event received\n");
-                gnrc_sixlowpan_frag_send(msg.content.ptr);
+                gnrc_sixlowpan_frag_send(msg->content.ptr);
                 break;
 #endif
 
@@ -14,6 +14,7 @@
 
 #include "net/eui64.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/ndp/internal.h"
 #include "net/gnrc/netif.h"
@@ -355,6 +356,10 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
                 }
                 nc_entry->flags &= ~GNRC_IPV6_NC_TYPE_MASK;
                 nc_entry->flags |= GNRC_IPV6_NC_TYPE_REGISTERED;
+#ifdef MODULE_GNRC_IPV6_DCACHE
+                /* registered neighbors are next hops themselves */
+                gnrc_ipv6_dcache_flush();
+#endif
                 reg_ltime = byteorder_ntohs(ar_opt->ltime);
                 /* TODO: notify routing protocol */
                 xtimer_set_msg(&nc_entry->type_timeout, (reg_ltime * 60 * SEC_IN_USEC),
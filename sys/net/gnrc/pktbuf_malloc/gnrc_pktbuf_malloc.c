@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer on top of a heap allocator
+ *
+ * Every data allocation carries a small header recording its size and the
+ * type it was allocated for, so usage can be accounted per protocol type
+ * and against the soft cap without asking the allocator.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _TYPE_NUMOF     (GNRC_NETTYPE_NUMOF - GNRC_NETTYPE_IOVEC)
+
+typedef union {
+    struct {
+        size_t size;            /* size of the data behind the header */
+        gnrc_nettype_t type;    /* type the data is accounted to */
+    } hdr;
+    uint64_t align;             /* keeps the data behind the header aligned */
+} _chunk_t;
+
+static const gnrc_pktbuf_allocator_t _default_allocator = {
+    .alloc = malloc,
+    .free = free,
+};
+
+static mutex_t _mutex = MUTEX_INIT;
+static const gnrc_pktbuf_allocator_t *_allocator = &_default_allocator;
+static size_t _limit = GNRC_PKTBUF_MALLOC_LIMIT;
+static size_t _used, _used_max;
+static size_t _usage[_TYPE_NUMOF];
+static unsigned _snips_used, _snips_max;
+
+#ifdef MODULE_GNRC_PKTBUF_STATS
+static gnrc_pktbuf_alloc_stats_t _stats;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    size_t headroom, gnrc_nettype_t type);
+
+static inline unsigned _type_idx(gnrc_nettype_t type)
+{
+    assert((type >= GNRC_NETTYPE_IOVEC) && (type < GNRC_NETTYPE_NUMOF));
+    return (unsigned)(type - GNRC_NETTYPE_IOVEC);
+}
+
+/* checks the soft cap and counts the allocation */
+static bool _reserve(size_t size)
+{
+#ifdef MODULE_GNRC_PKTBUF_STATS
+    _stats.alloc_num++;
+#endif
+    if ((_used + size) > _limit) {
+        DEBUG("pktbuf: allocating %u bytes would exceed the limit (%u of %u "
+              "used)\n", (unsigned)size, (unsigned)_used, (unsigned)_limit);
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        _stats.alloc_fail++;
+#endif
+        return false;
+    }
+    return true;
+}
+
+static void _account(size_t size)
+{
+    _used += size;
+    if (_used > _used_max) {
+        _used_max = _used;
+    }
+}
+
+static void *_data_alloc(size_t size, gnrc_nettype_t type)
+{
+    _chunk_t *chunk;
+
+    if (!_reserve(size)) {
+        return NULL;
+    }
+    chunk = _allocator->alloc(sizeof(_chunk_t) + size);
+    if (chunk == NULL) {
+        DEBUG("pktbuf: allocator is out of memory\n");
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        _stats.alloc_fail++;
+#endif
+        return NULL;
+    }
+    chunk->hdr.size = size;
+    chunk->hdr.type = type;
+    _account(size);
+    _usage[_type_idx(type)] += size;
+    return chunk + 1;
+}
+
+static void _data_free(void *data)
+{
+    _chunk_t *chunk = ((_chunk_t *)data) - 1;
+
+    _used -= chunk->hdr.size;
+    _usage[_type_idx(chunk->hdr.type)] -= chunk->hdr.size;
+    _allocator->free(chunk);
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (!_reserve(sizeof(gnrc_pktsnip_t))) {
+        return NULL;
+    }
+    pkt = _allocator->alloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: allocator is out of memory\n");
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        _stats.alloc_fail++;
+#endif
+        return NULL;
+    }
+    _account(sizeof(gnrc_pktsnip_t));
+    if (++_snips_used > _snips_max) {
+        _snips_max = _snips_used;
+    }
+    return pkt;
+}
+
+static void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    _used -= sizeof(gnrc_pktsnip_t);
+    _snips_used--;
+    _allocator->free(pkt);
+}
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+    pkt->headroom = 0;
+    pkt->headroom_free = 0;
+    pkt->borrowed = false;
+}
+
+/* frees the data of a snip including its headroom, unless it is borrowed */
+static inline void _free_data(gnrc_pktsnip_t *pkt)
+{
+    if (!pkt->borrowed && (pkt->data != NULL)) {
+        _data_free(((uint8_t *)pkt->data) - pkt->headroom);
+    }
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    /* packets still in the buffer are forgotten, like the static
+     * implementation does */
+    _used = 0;
+    _used_max = 0;
+    memset(_usage, 0, sizeof(_usage));
+    _snips_used = 0;
+    _snips_max = 0;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_malloc_set_allocator(const gnrc_pktbuf_allocator_t *allocator)
+{
+    mutex_lock(&_mutex);
+    assert(_used == 0);
+    _allocator = (allocator != NULL) ? allocator : &_default_allocator;
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_malloc_set_limit(size_t limit)
+{
+    mutex_lock(&_mutex);
+    _limit = limit;
+    mutex_unlock(&_mutex);
+}
+
+size_t gnrc_pktbuf_malloc_usage(gnrc_nettype_t type)
+{
+    size_t res;
+
+    mutex_lock(&_mutex);
+    res = _usage[_type_idx(type)];
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, 0, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (headroom > UINT16_MAX) {
+        DEBUG("pktbuf: headroom (%u) too large\n", (unsigned)headroom);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, headroom, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_prepend(gnrc_pktsnip_t *pkt, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *owner = pkt, *hdr;
+
+    if (pkt == NULL) {
+        return gnrc_pktbuf_add(NULL, NULL, size, type);
+    }
+    mutex_lock(&_mutex);
+    /* find the snip whose headroom pkt's data may lie in */
+    while ((owner != NULL) && owner->borrowed) {
+        owner = owner->next;
+    }
+    /* only use the headroom if pkt is at its front, otherwise some other
+     * snip, e.g. of another user of the packet, already claimed it */
+    if ((owner != NULL) && (size > 0) && (size <= owner->headroom_free) &&
+        (((uint8_t *)owner->data - (uint8_t *)pkt->data) ==
+         (owner->headroom - owner->headroom_free))) {
+        hdr = _snip_alloc();
+        if (hdr != NULL) {
+            _set_pktsnip(hdr, pkt, ((uint8_t *)pkt->data) - size, size, type);
+            hdr->borrowed = true;
+            owner->headroom_free -= size;
+        }
+    }
+    else {
+        hdr = _create_snip(pkt, NULL, size, 0, type);
+    }
+    mutex_unlock(&_mutex);
+    return hdr;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->size == size) {
+        /* marked snip takes over the data, and with it its headroom */
+        _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+        marked_snip->headroom = pkt->headroom;
+        marked_snip->headroom_free = pkt->headroom_free;
+        marked_snip->borrowed = pkt->borrowed;
+        pkt->data = NULL;
+        pkt->headroom = 0;
+        pkt->headroom_free = 0;
+        pkt->borrowed = false;
+    }
+    else {
+        /* a chunk can only be freed as a whole => copy both parts */
+        void *new_data_rest;
+
+        new_data_marked = _data_alloc(size, type);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _snip_free(marked_snip);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        new_data_rest = _data_alloc(pkt->size - size, pkt->type);
+        if (new_data_rest == NULL) {
+            DEBUG("pktbuf: could not reallocate remaining section.\n");
+            _data_free(new_data_marked);
+            _snip_free(marked_snip);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        /* snips in the headroom would be left dangling */
+        assert(pkt->headroom_free == pkt->headroom);
+        _free_data(pkt);
+        _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+        pkt->data = new_data_rest;
+        pkt->headroom = 0;
+        pkt->headroom_free = 0;
+        pkt->borrowed = false;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    void *new_data;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    if ((size > 0) && (size <= pkt->size)) {
+        /* shrink in place, the chunk is freed as a whole anyway */
+        pkt->size = size;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    if (size == 0) {
+        _free_data(pkt);
+        new_data = NULL;
+    }
+    else {
+        /* snips in the headroom would be left dangling */
+        assert(pkt->borrowed || (pkt->headroom_free == pkt->headroom));
+        new_data = _data_alloc(size, pkt->type);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {
+            memcpy(new_data, pkt->data, pkt->size);
+        }
+        _free_data(pkt);
+    }
+    pkt->data = new_data;
+    pkt->size = size;
+    pkt->headroom = 0;
+    pkt->headroom_free = 0;
+    pkt->borrowed = false;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+/* gives the headroom a snip was prepended into back to the snip owning it,
+ * unless another header was prepended in front of it in the meantime */
+static void _return_headroom(gnrc_pktsnip_t *hdr)
+{
+    gnrc_pktsnip_t *owner = hdr->next;
+    uint8_t *next_data, *start, *front;
+
+    if (owner == NULL) {
+        /* removed from its packet, the owner can't be found anymore */
+        return;
+    }
+    next_data = owner->data;
+    while ((owner != NULL) && owner->borrowed) {
+        owner = owner->next;
+    }
+    if ((owner == NULL) || (next_data == NULL)) {
+        return;
+    }
+    start = ((uint8_t *)owner->data) - owner->headroom;
+    front = start + owner->headroom_free;
+    if ((hdr->data == front) && (next_data > front) &&
+        (next_data <= (uint8_t *)owner->data)) {
+        owner->headroom_free = next_data - start;
+    }
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        tmp = pkt->next;
+        /* report before the last release hands the snip back to the heap */
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            if (pkt->borrowed) {
+                _return_headroom(pkt);
+            }
+            _free_data(pkt);
+            _snip_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, 0, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+/* checks if the data of b directly follows the one of a in memory, as it
+ * does for headers prepended into the headroom of a payload */
+static inline bool _contiguous(gnrc_pktsnip_t *a, gnrc_pktsnip_t *b)
+{
+    return (a->data != NULL) &&
+           (((uint8_t *)a->data) + a->size == (uint8_t *)b->data);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head, *prev = NULL;
+    struct iovec *vec;
+
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of IOVEC elements and allocate the IOVEC */
+    length = 1;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        if ((ptr == pkt->next) || !_contiguous(prev, ptr)) {
+            length++;
+        }
+        prev = ptr;
+    }
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC, the first element is never merged since drivers may
+     * replace it with their link-layer header */
+    vec->iov_base = pkt->data;
+    vec->iov_len = pkt->size;
+    prev = pkt;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        if ((ptr == pkt->next) || !_contiguous(prev, ptr)) {
+            ++vec;
+            vec->iov_base = ptr->data;
+            vec->iov_len = 0;
+        }
+        vec->iov_len += ptr->size;
+        prev = ptr;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    mutex_lock(&_mutex);
+    printf("packet buffer: %u of %u bytes used (max: %u), %u snips (max: %u)\n",
+           (unsigned)_used, (unsigned)_limit, (unsigned)_used_max,
+           _snips_used, _snips_max);
+    for (int type = GNRC_NETTYPE_IOVEC; type < GNRC_NETTYPE_NUMOF; type++) {
+        size_t usage = _usage[_type_idx((gnrc_nettype_t)type)];
+
+        if (usage > 0) {
+            printf("  nettype %2d: %u bytes\n", type, (unsigned)usage);
+        }
+    }
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_get_alloc_stats(gnrc_pktbuf_alloc_stats_t *stats)
+{
+    mutex_lock(&_mutex);
+    *stats = _stats;
+    stats->free_bytes = (_used < _limit) ? (_limit - _used) : 0;
+    stats->free_chunks = (stats->free_bytes > 0) ? 1 : 0;
+    stats->largest_free = stats->free_bytes;
+    stats->snips_used = _snips_used;
+    stats->snips_max = _snips_max;
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    return (_used == 0);
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    size_t data = 0;
+
+    /* Invariants of this implementation:
+     *  - all used bytes are either snip descriptors or accounted to a type
+     */
+    for (unsigned i = 0; i < _TYPE_NUMOF; i++) {
+        data += _usage[i];
+    }
+    return (data + (_snips_used * sizeof(gnrc_pktsnip_t))) == _used;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    size_t headroom, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    uint8_t *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size == 0) {
+        /* an empty snip has no data, so there is nothing to prepend to */
+        headroom = 0;
+    }
+    if ((size + headroom) > 0) {
+        _data = _data_alloc(size + headroom, type);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_free(pkt);
+            return NULL;
+        }
+        _data += headroom;
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    pkt->headroom = headroom;
+    pkt->headroom_free = headroom;
+    if ((data != NULL) && (size > 0)) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("pktbuf: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, 0, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
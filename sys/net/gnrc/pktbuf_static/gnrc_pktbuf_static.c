@@ -24,17 +24,25 @@
 #include <sys/types.h>
 #include <sys/uio.h>
 
+#include "atomic.h"
+#include "irq.h"
 #include "mutex.h"
 #include "od.h"
+#include "thread.h"
 #include "utlist.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/netif/hdr.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-#define _ALIGNMENT_MASK    (sizeof(void *) - 1)
+/* Chunks are multiples of _unused_t, so splitting a free chunk never leaves
+ * a remainder too small to be tracked in the free list. Otherwise these
+ * remainders are hidden in allocated chunks, and neighbouring ones that add
+ * up to a trackable size are never reclaimed. */
+#define _ALIGNMENT_MASK    (sizeof(_unused_t) - 1)
 
 typedef struct _unused {
     struct _unused *next;
@@ -44,6 +52,46 @@ typedef struct _unused {
 static mutex_t _mutex = MUTEX_INIT;
 static uint8_t _pktbuf[GNRC_PKTBUF_SIZE];
 static _unused_t *_first_unused;
+/* chunks released while another thread held the lock, freed by _lock() */
+static _unused_t *volatile _pending;
+
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+/* netif header with two addresses of maximum length */
+#define _NETIF_HDR_BLOCK_SIZE   (sizeof(gnrc_netif_hdr_t) + \
+                                 (2 * GNRC_NETIF_HDR_L2ADDR_MAX_LEN))
+
+/* free slab blocks are kept in a singly linked list */
+typedef struct _free_block {
+    struct _free_block *next;
+} _free_block_t;
+
+typedef union {
+    _free_block_t free;
+    uint8_t data[_NETIF_HDR_BLOCK_SIZE];
+} _netif_hdr_block_t;
+
+static gnrc_pktsnip_t _snip_slab[GNRC_PKTBUF_SNIP_NUMOF];
+static _netif_hdr_block_t _netif_hdr_slab[GNRC_PKTBUF_NETIF_HDR_NUMOF];
+static _free_block_t *_free_snips;
+static _free_block_t *_free_netif_hdrs;
+static unsigned _snips_used, _snips_max, _netif_hdrs_used;
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+/* slab blocks owned by a single thread, only ever touched by that thread */
+typedef struct {
+    _free_block_t *snips;
+    _free_block_t *netif_hdrs;
+    uint8_t snips_num;
+    uint8_t netif_hdrs_num;
+} _cache_t;
+
+static _cache_t _caches[MAXTHREADS];
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_STATS
+static gnrc_pktbuf_alloc_stats_t _stats;
+#endif
 
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
@@ -52,7 +100,7 @@ static uint16_t max_byte_count = 0;
 
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
-                                    gnrc_nettype_t type);
+                                    size_t headroom, gnrc_nettype_t type);
 static void *_pktbuf_alloc(size_t size);
 static void _pktbuf_free(void *data, size_t size);
 
@@ -61,6 +109,223 @@ static inline bool _pktbuf_contains(void *ptr)
     return (unsigned)((uint8_t *)ptr - _pktbuf) < GNRC_PKTBUF_SIZE;
 }
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+static inline bool _snip_slab_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - (uint8_t *)_snip_slab) < sizeof(_snip_slab);
+}
+
+static inline bool _netif_hdr_slab_contains(void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - (uint8_t *)_netif_hdr_slab) < sizeof(_netif_hdr_slab);
+}
+
+static inline void *_slab_alloc(_free_block_t **head)
+{
+    _free_block_t *block = *head;
+
+    if (block != NULL) {
+        *head = block->next;
+    }
+    return block;
+}
+
+static inline void _slab_free(_free_block_t **head, void *ptr)
+{
+    _free_block_t *block = ptr;
+
+    block->next = *head;
+    *head = block;
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+/* returns the cache of the calling thread or NULL in interrupt context */
+static inline _cache_t *_cache(void)
+{
+    kernel_pid_t pid = thread_getpid();
+
+    if (irq_is_in() || !pid_is_valid(pid)) {
+        return NULL;
+    }
+    return &_caches[pid - KERNEL_PID_FIRST];
+}
+
+static inline void *_cache_get(_free_block_t **cache, uint8_t *num)
+{
+    void *ptr = _slab_alloc(cache);
+
+    if (ptr != NULL) {
+        (*num)--;
+    }
+    return ptr;
+}
+
+static inline bool _cache_put(_free_block_t **cache, uint8_t *num, void *ptr)
+{
+    if (*num >= GNRC_PKTBUF_CACHE_SIZE) {
+        return false;
+    }
+    _slab_free(cache, ptr);
+    (*num)++;
+    return true;
+}
+
+/* moves up to half a cache worth of blocks from a slab to an empty cache,
+ * the packet buffer must be locked. The blocks are moved as one run of the
+ * slab's list, so they are handed out in the same order as from the slab. */
+static void _cache_refill(_free_block_t **cache, uint8_t *num,
+                          _free_block_t **slab, unsigned *used)
+{
+    _free_block_t *last = *slab;
+
+    assert(*cache == NULL);
+    if (last == NULL) {
+        return;
+    }
+    *cache = last;
+    *num = 1;
+    while ((*num < (GNRC_PKTBUF_CACHE_SIZE / 2)) && (last->next != NULL)) {
+        last = last->next;
+        (*num)++;
+    }
+    *slab = last->next;
+    last->next = NULL;
+    *used += *num;
+}
+
+/* returns all blocks of a cache to the slabs, the packet buffer must be locked */
+static void _cache_flush(_cache_t *cache)
+{
+    void *ptr;
+
+    while ((ptr = _cache_get(&cache->snips, &cache->snips_num)) != NULL) {
+        _slab_free(&_free_snips, ptr);
+        _snips_used--;
+    }
+    while ((ptr = _cache_get(&cache->netif_hdrs, &cache->netif_hdrs_num)) != NULL) {
+        _slab_free(&_free_netif_hdrs, ptr);
+        _netif_hdrs_used--;
+    }
+}
+#endif
+
+/* gnrc_pktsnip_t::users is an unsigned int to keep the API, but has the
+ * size of an int on all platforms, so it can be updated like an atomic_int_t */
+static inline unsigned _users_add(gnrc_pktsnip_t *pkt, int num)
+{
+    atomic_int_t *users = (atomic_int_t *)&pkt->users;
+    int old;
+
+    do {
+        old = ATOMIC_VALUE(*users);
+    } while (!atomic_cas(users, old, old + num));
+    return (unsigned)(old + num);
+}
+
+/* checks if ptr may point to the data of a packet snip */
+static inline bool _data_contains(void *ptr)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    if (_netif_hdr_slab_contains(ptr)) {
+        return true;
+    }
+#endif
+    return _pktbuf_contains(ptr);
+}
+
+static inline bool _snip_contains(void *ptr)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    return _snip_slab_contains(ptr);
+#else
+    return _pktbuf_contains(ptr);
+#endif
+}
+
+static gnrc_pktsnip_t *_snip_alloc(void)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    gnrc_pktsnip_t *pkt = NULL;
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    _cache_t *cache = _cache();
+
+    if (cache != NULL) {
+        if (cache->snips == NULL) {
+            _cache_refill(&cache->snips, &cache->snips_num, &_free_snips,
+                          &_snips_used);
+        }
+        pkt = _cache_get(&cache->snips, &cache->snips_num);
+    }
+#endif
+    if ((pkt == NULL) && ((pkt = _slab_alloc(&_free_snips)) != NULL)) {
+        _snips_used++;
+    }
+    if (pkt == NULL) {
+        DEBUG("pktbuf: no packet snip descriptor left\n");
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        _stats.alloc_fail++;
+#endif
+        return NULL;
+    }
+    if (_snips_used > _snips_max) {
+        _snips_max = _snips_used;
+    }
+    return pkt;
+#else
+    return _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+#endif
+}
+
+static void _snip_free(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    _cache_t *cache = _cache();
+
+    if ((cache != NULL) &&
+        _cache_put(&cache->snips, &cache->snips_num, pkt)) {
+        return;
+    }
+#endif
+    _slab_free(&_free_snips, pkt);
+    _snips_used--;
+#else
+    _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+#endif
+}
+
+static void *_data_alloc(size_t size, gnrc_nettype_t type)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    if ((type == GNRC_NETTYPE_NETIF) && (size <= _NETIF_HDR_BLOCK_SIZE)) {
+        void *data = NULL;
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+        _cache_t *cache = _cache();
+
+        if (cache != NULL) {
+            if (cache->netif_hdrs == NULL) {
+                _cache_refill(&cache->netif_hdrs, &cache->netif_hdrs_num,
+                              &_free_netif_hdrs, &_netif_hdrs_used);
+            }
+            data = _cache_get(&cache->netif_hdrs, &cache->netif_hdrs_num);
+        }
+#endif
+        if ((data == NULL) &&
+            ((data = _slab_alloc(&_free_netif_hdrs)) != NULL)) {
+            _netif_hdrs_used++;
+        }
+        if (data != NULL) {
+            return data;
+        }
+        /* slab exhausted, fall back to the arena */
+    }
+#else
+    (void)type;
+#endif
+    return _pktbuf_alloc(size);
+}
+
 /* fits size to byte alignment */
 static inline size_t _align(size_t size)
 {
@@ -78,7 +343,178 @@ static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+    pkt->headroom = 0;
+    pkt->headroom_free = 0;
+    pkt->borrowed = false;
+}
+
+/* frees the data of a snip including its headroom, unless it is borrowed */
+static inline void _free_data(gnrc_pktsnip_t *pkt)
+{
+    if (!pkt->borrowed) {
+        _pktbuf_free(((uint8_t *)pkt->data) - pkt->headroom,
+                     pkt->size + pkt->headroom);
+    }
+}
+
+/* frees a snip descriptor or a chunk of data, the packet buffer must be locked */
+static void _free_chunk(void *ptr, size_t size)
+{
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    if (_snip_slab_contains(ptr)) {
+        _snip_free(ptr);
+        return;
+    }
+#endif
+    _pktbuf_free(ptr, size);
+}
+
+/* frees the chunks released while the lock was held by another thread */
+static void _drain(void)
+{
+    unsigned state = irq_disable();
+    _unused_t *chunk = _pending;
+
+    _pending = NULL;
+    irq_restore(state);
+    while (chunk != NULL) {
+        _unused_t *next = chunk->next;
+
+        _free_chunk(chunk, chunk->size);
+        chunk = next;
+    }
+}
+
+static inline void _lock(void)
+{
+    mutex_lock(&_mutex);
+    _drain();
+}
+
+/* gives back a chunk of a released snip without blocking: slab blocks go to
+ * the cache of the calling thread, other chunks are freed if the caller holds
+ * the lock or queued for _drain() otherwise. Returns true if queued. */
+static bool _put(void *ptr, size_t size, bool locked)
+{
+    unsigned state;
+    _unused_t *chunk = ptr;
+
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    _cache_t *cache = _cache();
+
+    if (cache != NULL) {
+        if (_snip_slab_contains(ptr) &&
+            _cache_put(&cache->snips, &cache->snips_num, ptr)) {
+            return false;
+        }
+        if (_netif_hdr_slab_contains(ptr) &&
+            _cache_put(&cache->netif_hdrs, &cache->netif_hdrs_num, ptr)) {
+            return false;
+        }
+    }
+#endif
+    if (locked) {
+        _free_chunk(ptr, size);
+        return false;
+    }
+    if (!_data_contains(ptr) && !_snip_contains(ptr)) {
+        return false;   /* e.g. NULL data of an empty snip */
+    }
+    /* every chunk fits an _unused_t, see _ALIGNMENT_MASK */
+    chunk->size = size;
+    state = irq_disable();
+    chunk->next = _pending;
+    _pending = chunk;
+    irq_restore(state);
+    return true;
+}
+
+/* gives the headroom a snip was prepended into back to the snip owning it,
+ * unless another header was prepended in front of it in the meantime */
+static void _return_headroom(gnrc_pktsnip_t *hdr)
+{
+    gnrc_pktsnip_t *owner = hdr->next;
+    uint8_t *next_data;
+    unsigned state;
+
+    if (owner == NULL) {
+        /* removed from its packet, the owner can't be found anymore */
+        return;
+    }
+    next_data = owner->data;
+    while ((owner != NULL) && owner->borrowed) {
+        owner = owner->next;
+    }
+    if ((owner == NULL) || (next_data == NULL)) {
+        return;
+    }
+    /* releases don't lock the packet buffer, so this is synchronized with
+     * gnrc_pktbuf_prepend() by disabling interrupts */
+    state = irq_disable();
+    uint8_t *start = ((uint8_t *)owner->data) - owner->headroom;
+    uint8_t *front = start + owner->headroom_free;
+
+    if ((hdr->data == front) && (next_data > front) &&
+        (next_data <= (uint8_t *)owner->data)) {
+        owner->headroom_free = next_data - start;
+    }
+    irq_restore(state);
+}
+
+/* gives back data and descriptor of a snip with no users left */
+static bool _put_snip(gnrc_pktsnip_t *pkt, bool locked)
+{
+    bool queued = false;
+
+    if (pkt->borrowed) {
+        _return_headroom(pkt);
+    }
+    else {
+        queued = _put(((uint8_t *)pkt->data) - pkt->headroom,
+                      pkt->size + pkt->headroom, locked);
+    }
+    return _put(pkt, sizeof(gnrc_pktsnip_t), locked) || queued;
+}
+
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+/* creates a snip without data or with a netif header from the cache of the
+ * calling thread without locking the packet buffer */
+static gnrc_pktsnip_t *_cache_create_snip(gnrc_pktsnip_t *next, void *data,
+                                          size_t size, gnrc_nettype_t type)
+{
+    _cache_t *cache = _cache();
+    gnrc_pktsnip_t *pkt;
+    void *_data = NULL;
+
+    if ((cache == NULL) || (cache->snips == NULL)) {
+        return NULL;
+    }
+    if (size > 0) {
+        if ((type != GNRC_NETTYPE_NETIF) || (size > _NETIF_HDR_BLOCK_SIZE) ||
+            (cache->netif_hdrs == NULL)) {
+            return NULL;
+        }
+        _data = _cache_get(&cache->netif_hdrs, &cache->netif_hdrs_num);
+    }
+    pkt = _cache_get(&cache->snips, &cache->snips_num);
+    _set_pktsnip(pkt, next, _data, size, type);
+    if ((data != NULL) && (_data != NULL)) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+void gnrc_pktbuf_cache_flush(void)
+{
+    _cache_t *cache = _cache();
+
+    if (cache != NULL) {
+        _lock();
+        _cache_flush(cache);
+        mutex_unlock(&_mutex);
+    }
 }
+#endif
 
 void gnrc_pktbuf_init(void)
 {
@@ -86,6 +522,23 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+    _pending = NULL;
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    memset(_caches, 0, sizeof(_caches));
+#endif
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    /* push in reverse, so blocks are handed out in ascending order */
+    _free_snips = NULL;
+    for (int i = GNRC_PKTBUF_SNIP_NUMOF - 1; i >= 0; i--) {
+        _slab_free(&_free_snips, &_snip_slab[i]);
+    }
+    _free_netif_hdrs = NULL;
+    for (int i = GNRC_PKTBUF_NETIF_HDR_NUMOF - 1; i >= 0; i--) {
+        _slab_free(&_free_netif_hdrs, &_netif_hdr_slab[i]);
+    }
+    _snips_used = 0;
+    _netif_hdrs_used = 0;
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -99,12 +552,87 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
               (unsigned)size, GNRC_PKTBUF_SIZE);
         return NULL;
     }
-    mutex_lock(&_mutex);
-    pkt = _create_snip(next, data, size, type);
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    if ((pkt = _cache_create_snip(next, data, size, type)) != NULL) {
+        return pkt;
+    }
+#endif
+    _lock();
+    pkt = _create_snip(next, data, size, 0, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_headroom(gnrc_pktsnip_t *next, void *data,
+                                         size_t size, size_t headroom,
+                                         gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (((size + headroom) > GNRC_PKTBUF_SIZE) || (headroom > UINT16_MAX)) {
+        DEBUG("pktbuf: size (%u) + headroom (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, (unsigned)headroom, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    _lock();
+    pkt = _create_snip(next, data, size, headroom, type);
     mutex_unlock(&_mutex);
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_prepend(gnrc_pktsnip_t *pkt, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *owner = pkt, *hdr;
+
+    if (pkt == NULL) {
+        return gnrc_pktbuf_add(NULL, NULL, size, type);
+    }
+    _lock();
+    /* find the snip whose headroom pkt's data may lie in */
+    while ((owner != NULL) && owner->borrowed) {
+        owner = owner->next;
+    }
+    /* only use the headroom if pkt is at its front, otherwise some other
+     * snip, e.g. of another user of the packet, already claimed it */
+    if ((owner != NULL) && (size > 0)) {
+        /* headroom is given back by releases without the lock held, see
+         * _return_headroom() */
+        unsigned state = irq_disable();
+
+        if ((size <= owner->headroom_free) &&
+            (((uint8_t *)owner->data - (uint8_t *)pkt->data) ==
+             (owner->headroom - owner->headroom_free))) {
+            owner->headroom_free -= size;
+        }
+        else {
+            owner = NULL;
+        }
+        irq_restore(state);
+    }
+    else {
+        owner = NULL;
+    }
+    if (owner != NULL) {
+        hdr = _snip_alloc();
+        if (hdr != NULL) {
+            _set_pktsnip(hdr, pkt, ((uint8_t *)pkt->data) - size, size, type);
+            hdr->borrowed = true;
+        }
+        else {
+            unsigned state = irq_disable();
+
+            owner->headroom_free += size;
+            irq_restore(state);
+        }
+    }
+    else {
+        hdr = _create_snip(pkt, NULL, size, 0, type);
+    }
+    mutex_unlock(&_mutex);
+    return hdr;
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
@@ -113,7 +641,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
                                _align(sizeof(_unused_t)) : _align(size);
     void *new_data_marked;
 
-    mutex_lock(&_mutex);
+    _lock();
     if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
         DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
               "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
@@ -123,37 +651,44 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* create new snip descriptor for marked data */
-    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    marked_snip = _snip_alloc();
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
         mutex_unlock(&_mutex);
         return NULL;
     }
-    /* marked data would not fit _unused_t marker => move data around to allow
-     * for proper free */
+    /* marked data would not fit _unused_t marker or data is in a slab block,
+     * a headroom buffer, or borrowed that can only be freed as a whole
+     * => move data around to allow for proper free */
     if ((pkt->size != size) &&
-        ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t)))) {
+        ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t)) ||
+         !_pktbuf_contains(pkt->data) || pkt->headroom || pkt->borrowed)) {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _snip_free(marked_snip);
             mutex_unlock(&_mutex);
             return NULL;
         }
         new_data_rest = _pktbuf_alloc(pkt->size - size);
         if (new_data_rest == NULL) {
             DEBUG("pktbuf: could not reallocate remaining section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _snip_free(marked_snip);
             _pktbuf_free(new_data_marked, size);
             mutex_unlock(&_mutex);
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
-        _pktbuf_free(pkt->data, pkt->size);
+        /* snips in the headroom would be left dangling */
+        assert(pkt->headroom_free == pkt->headroom);
+        _free_data(pkt);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
+        pkt->headroom = 0;
+        pkt->headroom_free = 0;
+        pkt->borrowed = false;
     }
     else {
         new_data_marked = pkt->data;
@@ -161,8 +696,17 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
                                           NULL;
     }
-    pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    if (pkt->size == size) {
+        /* marked snip takes over the data, and with it its headroom */
+        marked_snip->headroom = pkt->headroom;
+        marked_snip->headroom_free = pkt->headroom_free;
+        marked_snip->borrowed = pkt->borrowed;
+        pkt->headroom = 0;
+        pkt->headroom_free = 0;
+        pkt->borrowed = false;
+    }
+    pkt->size -= size;
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -173,22 +717,61 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     size_t aligned_size = (size < sizeof(_unused_t)) ?
                           _align(sizeof(_unused_t)) : _align(size);
 
-    mutex_lock(&_mutex);
+    _lock();
     assert(pkt != NULL);
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
-           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+           ((pkt->size > 0) && (pkt->data != NULL) && _data_contains(pkt->data)));
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
         mutex_unlock(&_mutex);
         return 0;
     }
+    if (pkt->borrowed && (size <= pkt->size)) {
+        /* the data is freed with the snip owning the headroom */
+        if (size == 0) {
+            pkt->data = NULL;
+            pkt->borrowed = false;
+        }
+        pkt->size = size;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    if (pkt->borrowed || pkt->headroom) {
+        /* data can't be split, so move it to a new chunk */
+        void *new_data = NULL;
+
+        /* snips in the headroom would be left dangling */
+        assert(pkt->borrowed || (pkt->headroom_free == pkt->headroom));
+        if (size > 0) {
+            new_data = _pktbuf_alloc(size);
+            if (new_data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                mutex_unlock(&_mutex);
+                return ENOMEM;
+            }
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        _free_data(pkt);
+        pkt->data = new_data;
+        pkt->size = size;
+        pkt->headroom = 0;
+        pkt->headroom_free = 0;
+        pkt->borrowed = false;
+        mutex_unlock(&_mutex);
+        return 0;
+    }
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = NULL;
     }
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    else if (_netif_hdr_slab_contains(pkt->data) && (size <= _NETIF_HDR_BLOCK_SIZE)) {
+        /* data still fits its slab block */
+    }
+#endif
     /* if new size is bigger than old size */
     else if ((size > pkt->size) ||                          /* new size does not fit */
         ((pkt->size - aligned_size) < sizeof(_unused_t))) { /* resulting hole would not fit marker */
@@ -215,53 +798,54 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 
 void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
 {
-    mutex_lock(&_mutex);
     while (pkt) {
-        pkt->users += num;
+        _users_add(pkt, num);
         pkt = pkt->next;
     }
-    mutex_unlock(&_mutex);
 }
 
-static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+static void _release_error(gnrc_pktsnip_t *pkt, uint32_t err, bool locked)
 {
+    bool queued = false;
+
     while (pkt) {
         gnrc_pktsnip_t *tmp;
-        assert(_pktbuf_contains(pkt));
+        assert(_snip_contains(pkt));
+        /* the snip may be freed by another user as soon as we dropped our
+         * reference, so everything we need is read before */
         tmp = pkt->next;
-        if (pkt->users == 1) {
-            pkt->users = 0; /* not necessary but to be on the safe side */
-            _pktbuf_free(pkt->data, pkt->size);
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
-        }
-        else {
-            pkt->users--;
-        }
         DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
         gnrc_neterr_report(pkt, err);
+        if (_users_add(pkt, -1) == 0) {
+            queued |= _put_snip(pkt, locked);
+        }
         pkt = tmp;
     }
+    /* don't leave queued chunks around if nobody else uses the buffer */
+    if (queued && !irq_is_in() && mutex_trylock(&_mutex)) {
+        _drain();
+        mutex_unlock(&_mutex);
+    }
 }
 
 void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
 {
-    mutex_lock(&_mutex);
-    _release_error_locked(pkt, err);
-    mutex_unlock(&_mutex);
+    _release_error(pkt, err, false);
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 {
-    mutex_lock(&_mutex);
+    _lock();
     if ((pkt == NULL) || (pkt->size == 0)) {
         mutex_unlock(&_mutex);
         return NULL;
     }
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
-        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
-        if (new != NULL) {
-            pkt->users--;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, 0, pkt->type);
+        if ((new != NULL) && (_users_add(pkt, -1) == 0)) {
+            /* all other users released it in the meantime */
+            _put_snip(pkt, true);
         }
         mutex_unlock(&_mutex);
         return new;
@@ -270,10 +854,18 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     return pkt;
 }
 
+/* checks if the data of b directly follows the one of a in memory, as it
+ * does for headers prepended into the headroom of a payload */
+static inline bool _contiguous(gnrc_pktsnip_t *a, gnrc_pktsnip_t *b)
+{
+    return (a->data != NULL) &&
+           (((uint8_t *)a->data) + a->size == (uint8_t *)b->data);
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
 {
     size_t length;
-    gnrc_pktsnip_t *head;
+    gnrc_pktsnip_t *head, *prev = NULL;
     struct iovec *vec;
 
     if (pkt == NULL) {
@@ -281,8 +873,14 @@ gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
         return NULL;
     }
 
-    /* count the number of snips in the packet and allocate the IOVEC */
-    length = gnrc_pkt_count(pkt);
+    /* count the number of IOVEC elements and allocate the IOVEC */
+    length = 1;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        if ((ptr == pkt->next) || !_contiguous(prev, ptr)) {
+            length++;
+        }
+        prev = ptr;
+    }
     head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
                            GNRC_NETTYPE_IOVEC);
     if (head == NULL) {
@@ -290,12 +888,19 @@ gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
         return NULL;
     }
     vec = (struct iovec *)(head->data);
-    /* fill the IOVEC */
-    while (pkt != NULL) {
-        vec->iov_base = pkt->data;
-        vec->iov_len = pkt->size;
-        ++vec;
-        pkt = pkt->next;
+    /* fill the IOVEC, the first element is never merged since drivers may
+     * replace it with their link-layer header */
+    vec->iov_base = pkt->data;
+    vec->iov_len = pkt->size;
+    prev = pkt;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        if ((ptr == pkt->next) || !_contiguous(prev, ptr)) {
+            ++vec;
+            vec->iov_base = ptr->data;
+            vec->iov_len = 0;
+        }
+        vec->iov_len += ptr->size;
+        prev = ptr;
     }
     *len = length;
     return head;
@@ -360,11 +965,51 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+void gnrc_pktbuf_get_alloc_stats(gnrc_pktbuf_alloc_stats_t *stats)
+{
+    _lock();
+    *stats = _stats;
+    stats->free_bytes = 0;
+    stats->free_chunks = 0;
+    stats->largest_free = 0;
+    for (_unused_t *ptr = _first_unused; ptr != NULL; ptr = ptr->next) {
+        stats->free_bytes += ptr->size;
+        stats->free_chunks++;
+        if (ptr->size > stats->largest_free) {
+            stats->largest_free = ptr->size;
+        }
+    }
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    stats->snips_used = _snips_used;
+    stats->snips_max = _snips_max;
+#endif
+    mutex_unlock(&_mutex);
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
-    return (_first_unused == (_unused_t *)_pktbuf) &&
-           (_first_unused->size == sizeof(_pktbuf));
+    bool res;
+
+    _lock();
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    _cache_t *cache = _cache();
+
+    if (cache != NULL) {
+        _cache_flush(cache);
+    }
+#endif
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    res = (_snips_used == 0) && (_netif_hdrs_used == 0);
+#else
+    res = true;
+#endif
+    res = res && (_first_unused == (_unused_t *)_pktbuf) &&
+          (_first_unused->size == sizeof(_pktbuf));
+    mutex_unlock(&_mutex);
+    return res;
 }
 
 bool gnrc_pktbuf_is_sane(void)
@@ -400,24 +1045,31 @@ bool gnrc_pktbuf_is_sane(void)
 #endif
 
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
-                                    gnrc_nettype_t type)
+                                    size_t headroom, gnrc_nettype_t type)
 {
-    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
-    void *_data = NULL;
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    uint8_t *_data = NULL;
 
     if (pkt == NULL) {
         DEBUG("pktbuf: error allocating new packet snip\n");
         return NULL;
     }
-    if (size > 0) {
-        _data = _pktbuf_alloc(size);
+    if (size == 0) {
+        /* an empty snip has no data, so there is nothing to prepend to */
+        headroom = 0;
+    }
+    if ((size + headroom) > 0) {
+        _data = _data_alloc(size + headroom, type);
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _snip_free(pkt);
             return NULL;
         }
+        _data += headroom;
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    pkt->headroom = headroom;
+    pkt->headroom_free = headroom;
     if (data != NULL) {
         memcpy(_data, data, size);
     }
@@ -428,13 +1080,30 @@ static void *_pktbuf_alloc(size_t size)
 {
     _unused_t *prev = NULL, *ptr = _first_unused;
 
+#ifdef MODULE_GNRC_PKTBUF_STATS
+    uint32_t walk = 1;
+#endif
+
     size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
     while (ptr && (size > ptr->size)) {
         prev = ptr;
         ptr = ptr->next;
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        walk++;
+#endif
+    }
+#ifdef MODULE_GNRC_PKTBUF_STATS
+    _stats.alloc_num++;
+    _stats.alloc_walk += walk;
+    if (walk > _stats.alloc_walk_max) {
+        _stats.alloc_walk_max = walk;
     }
+#endif
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+#ifdef MODULE_GNRC_PKTBUF_STATS
+        _stats.alloc_fail++;
+#endif
         return NULL;
     }
     if (sizeof(_unused_t) > (ptr->size - size)) {
@@ -483,6 +1152,21 @@ static void _pktbuf_free(void *data, size_t size)
 {
     _unused_t *new = (_unused_t *)data, *prev = NULL, *ptr = _first_unused;
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+    if (_netif_hdr_slab_contains(data)) {
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+        _cache_t *cache = _cache();
+
+        if ((cache != NULL) &&
+            _cache_put(&cache->netif_hdrs, &cache->netif_hdrs_num, data)) {
+            return;
+        }
+#endif
+        _slab_free(&_free_netif_hdrs, data);
+        _netif_hdrs_used--;
+        return;
+    }
+#endif
     if (!_pktbuf_contains(data)) {
         return;
     }
@@ -541,7 +1225,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *ol
 
 gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
 {
-    mutex_lock(&_mutex);
+    _lock();
 
     bool is_shared = pkt->users > 1;
     size_t size = gnrc_pkt_len_upto(pkt, type);
@@ -551,7 +1235,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
     gnrc_pktsnip_t *tmp;
     gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
     gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
-    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, 0, type);
 
     if (new == NULL) {
         mutex_unlock(&_mutex);
@@ -578,7 +1262,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
         target->next = NULL;
     }
 
-    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+    _release_error(pkt, GNRC_NETERR_SUCCESS, true);
 
     if (is_shared && (target != NULL)) {
         target->next = next;
@@ -265,7 +265,9 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
          * there was no remote given on create, take from local */
         rem.family = local.family;
     }
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    /* reserve space for the UDP and IPv6 header in front of the payload */
+    payload = gnrc_pktbuf_add_headroom(NULL, (void *)data, len,
+                                       GNRC_PKTBUF_HEADROOM, GNRC_NETTYPE_UNDEF);
     if (payload == NULL) {
         return -ENOMEM;
     }
@@ -145,7 +145,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    if (!gnrc_netif_hdr_csum_valid(pkt) && (_calc_csum(udp, ipv6, pkt) != 0xFFFF)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -283,8 +283,8 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
     gnrc_pktsnip_t *res;
     udp_hdr_t *hdr;
 
-    /* allocate header */
-    res = gnrc_pktbuf_add(payload, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    /* allocate header, into the payload's headroom if possible */
+    res = gnrc_pktbuf_prepend(payload, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
     if (res == NULL) {
         return NULL;
     }
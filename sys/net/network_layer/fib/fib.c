@@ -24,6 +24,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "assert.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -64,6 +65,422 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now64() + (ms * 1000);
 }
 
+/**
+ * @brief Longest prefix match index of single hop tables
+ *
+ * A path-compressed binary trie over the keys of all entries. A key is the
+ * address size as first byte followed by the address. Its significant bits
+ * are the size byte plus the prefix bits for prefix entries, plus all
+ * address bits for host entries, and only the size byte for the all-zero
+ * address, i.e. the default route of an address type.
+ *
+ * Node `i << 1` is embedded in entry `i`. Node `(i << 1) | 1` is a branch
+ * node for a split between keys without an entry of its own. Branch nodes
+ * are taken from a free list, since there are always less of them than
+ * entries. Entries with equal key bits are chained by fib_lpm_node_t::dup,
+ * only the first of them is in the trie.
+ */
+#define LPM_NIL             (0xffff)
+#define LPM_DUP             (0xfffe)    /**< child marker of chained entries */
+#define LPM_IS_BRANCH(id)   ((id) & 1)
+
+typedef struct {
+    const uint8_t *addr;
+    uint8_t size;
+} _lpm_key_t;
+
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+static inline fib_lpm_node_t *_lpm_node(fib_table_t *table, uint16_t id)
+{
+    return &table->data.entries[id >> 1].lpm[id & 1];
+}
+
+static inline _lpm_key_t _lpm_entry_key(fib_table_t *table, uint16_t idx)
+{
+    universal_address_container_t *global = table->data.entries[idx].global;
+    _lpm_key_t key = { global->address, global->address_size };
+
+    return key;
+}
+
+static inline uint8_t _lpm_key_byte(const _lpm_key_t *key, unsigned idx)
+{
+    return (idx == 0) ? key->size : key->addr[idx - 1];
+}
+
+static inline unsigned _lpm_key_bit(const _lpm_key_t *key, unsigned pos)
+{
+    return (_lpm_key_byte(key, pos >> 3) >> (7 - (pos & 7))) & 1;
+}
+
+/* returns the position of the first bit in [from, to) that differs between
+ * a and b, or to if there is none */
+static unsigned _lpm_key_match(const _lpm_key_t *a, const _lpm_key_t *b,
+                               unsigned from, unsigned to)
+{
+    unsigned pos = from;
+
+    while (pos < to) {
+        uint8_t diff = (_lpm_key_byte(a, pos >> 3) ^ _lpm_key_byte(b, pos >> 3)) &
+                       (0xff >> (pos & 7));
+
+        pos &= ~7U;
+        if (diff) {
+            while (!(diff & 0x80)) {
+                diff <<= 1;
+                pos++;
+            }
+            return (pos < to) ? pos : to;
+        }
+        pos += 8;
+    }
+    return to;
+}
+
+static uint16_t _lpm_entry_bits(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    size_t bits = global->address_size << 3;
+    size_t prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) >>
+                    FIB_FLAG_NET_PREFIX_SHIFT;
+    size_t i;
+
+    for (i = 0; (i < global->address_size) && (global->address[i] == 0); i++) {}
+    if (i == global->address_size) {
+        return 8;
+    }
+    if ((prefix > 0) && (prefix < bits)) {
+        bits = prefix;
+    }
+    return 8 + bits;
+}
+
+static void _lpm_init(fib_table_t *table)
+{
+    table->lpm_root = LPM_NIL;
+    table->lpm_free = LPM_NIL;
+    for (size_t i = table->size; i > 0; i--) {
+        uint16_t id = ((i - 1) << 1) | 1;
+
+        _lpm_node(table, id)->child[0] = table->lpm_free;
+        table->lpm_free = id;
+    }
+}
+
+/* puts node id in the place of node old below parent */
+static void _lpm_replace(fib_table_t *table, uint16_t parent, uint16_t old,
+                         uint16_t id)
+{
+    if (parent == LPM_NIL) {
+        table->lpm_root = id;
+    }
+    else {
+        fib_lpm_node_t *p = _lpm_node(table, parent);
+
+        p->child[p->child[1] == old] = id;
+    }
+    if (id != LPM_NIL) {
+        _lpm_node(table, id)->parent = parent;
+    }
+}
+
+static void _lpm_adopt(fib_table_t *table, uint16_t id)
+{
+    fib_lpm_node_t *node = _lpm_node(table, id);
+
+    for (unsigned i = 0; i < 2; i++) {
+        if (node->child[i] != LPM_NIL) {
+            _lpm_node(table, node->child[i])->parent = id;
+        }
+    }
+}
+
+static void _lpm_insert(fib_table_t *table, uint16_t idx)
+{
+    uint16_t id = idx << 1, cur = table->lpm_root, parent = LPM_NIL;
+    fib_lpm_node_t *node = _lpm_node(table, id);
+    _lpm_key_t key = _lpm_entry_key(table, idx);
+    unsigned pos = 0;
+
+    node->child[0] = LPM_NIL;
+    node->child[1] = LPM_NIL;
+    node->bits = _lpm_entry_bits(&table->data.entries[idx]);
+    node->key = idx;
+    node->dup = LPM_NIL;
+
+    while (cur != LPM_NIL) {
+        fib_lpm_node_t *c = _lpm_node(table, cur);
+        _lpm_key_t ckey = _lpm_entry_key(table, c->key);
+
+        pos = _lpm_key_match(&key, &ckey, pos,
+                             (node->bits < c->bits) ? node->bits : c->bits);
+        if (pos < c->bits) {
+            if (pos == node->bits) {
+                /* the new key is a prefix of cur */
+                node->child[_lpm_key_bit(&ckey, pos)] = cur;
+            }
+            else {
+                /* the keys differ within cur, split with a branch node */
+                uint16_t branch = table->lpm_free;
+                fib_lpm_node_t *b = _lpm_node(table, branch);
+
+                assert(branch != LPM_NIL);
+                table->lpm_free = b->child[0];
+                b->bits = pos;
+                b->key = idx;
+                b->dup = LPM_NIL;
+                b->child[_lpm_key_bit(&key, pos)] = id;
+                b->child[_lpm_key_bit(&ckey, pos)] = cur;
+                node->parent = branch;
+                id = branch;
+            }
+            _lpm_replace(table, parent, cur, id);
+            c->parent = id;
+            return;
+        }
+        if (pos == node->bits) {
+            if (LPM_IS_BRANCH(cur)) {
+                /* the entry takes the place of the branch node */
+                node->child[0] = c->child[0];
+                node->child[1] = c->child[1];
+                _lpm_replace(table, parent, cur, id);
+                _lpm_adopt(table, id);
+                c->child[0] = table->lpm_free;
+                table->lpm_free = cur;
+            }
+            else {
+                node->child[0] = LPM_DUP;
+                node->parent = cur;
+                node->dup = c->dup;
+                if (c->dup != LPM_NIL) {
+                    _lpm_node(table, c->dup)->parent = id;
+                }
+                c->dup = id;
+            }
+            return;
+        }
+        parent = cur;
+        cur = c->child[_lpm_key_bit(&key, c->bits)];
+    }
+    if (parent == LPM_NIL) {
+        table->lpm_root = id;
+    }
+    else {
+        fib_lpm_node_t *p = _lpm_node(table, parent);
+
+        p->child[_lpm_key_bit(&key, p->bits)] = id;
+    }
+    node->parent = parent;
+}
+
+static void _lpm_remove(fib_table_t *table, uint16_t idx)
+{
+    uint16_t id = idx << 1;
+    fib_lpm_node_t *node = _lpm_node(table, id);
+    uint16_t parent = node->parent, fix = parent;
+
+    if (node->child[0] == LPM_DUP) {
+        /* chained behind an entry with the same key, parent is the previous */
+        _lpm_node(table, parent)->dup = node->dup;
+        if (node->dup != LPM_NIL) {
+            _lpm_node(table, node->dup)->parent = parent;
+        }
+        return;
+    }
+    if (node->dup != LPM_NIL) {
+        /* the next entry with the same key takes our place */
+        uint16_t next = node->dup;
+        fib_lpm_node_t *n = _lpm_node(table, next);
+
+        n->child[0] = node->child[0];
+        n->child[1] = node->child[1];
+        _lpm_replace(table, parent, id, next);
+        _lpm_adopt(table, next);
+    }
+    else if ((node->child[0] != LPM_NIL) && (node->child[1] != LPM_NIL)) {
+        /* still needed to branch, so replace it by a branch node */
+        uint16_t branch = table->lpm_free;
+        fib_lpm_node_t *b = _lpm_node(table, branch);
+
+        assert(branch != LPM_NIL);
+        table->lpm_free = b->child[0];
+        b->bits = node->bits;
+        b->key = _lpm_node(table, node->child[0])->key;
+        b->dup = LPM_NIL;
+        b->child[0] = node->child[0];
+        b->child[1] = node->child[1];
+        _lpm_replace(table, parent, id, branch);
+        _lpm_adopt(table, branch);
+    }
+    else if ((node->child[0] != LPM_NIL) || (node->child[1] != LPM_NIL)) {
+        _lpm_replace(table, parent, id,
+                     node->child[(node->child[0] == LPM_NIL)]);
+    }
+    else {
+        _lpm_replace(table, parent, id, LPM_NIL);
+        if ((parent != LPM_NIL) && LPM_IS_BRANCH(parent)) {
+            /* a branch node with a single child is not needed anymore */
+            fib_lpm_node_t *p = _lpm_node(table, parent);
+
+            fix = p->parent;
+            _lpm_replace(table, fix, parent, p->child[p->child[0] == LPM_NIL]);
+            p->child[0] = table->lpm_free;
+            table->lpm_free = parent;
+        }
+    }
+    /* branch nodes above may still take their key bits from the entry */
+    for (; fix != LPM_NIL; fix = _lpm_node(table, fix)->parent) {
+        fib_lpm_node_t *f = _lpm_node(table, fix);
+
+        if (LPM_IS_BRANCH(fix) && (f->key == idx)) {
+            f->key = _lpm_node(table, f->child[0])->key;
+        }
+    }
+}
+
+/**
+ * @brief Expiry order of single hop tables
+ *
+ * Entries with a lifetime are kept in a circular list ordered by their
+ * absolute expiry time, fib_table_t::expiry_head being the first to expire.
+ * A single timer is armed for the head. As lifetimes are mostly refreshed to
+ * the same duration, new deadlines are searched for from the tail.
+ */
+#define EXPIRY_NIL          (0xffff)
+#define EXPIRY_MAX_OFFSET   (0x7fffffffUL)  /**< longest timer offset in us */
+#define EXPIRY_RETRY        (10000U)        /**< delay in us before the expiry
+                                             *   thread is told again if its
+                                             *   queue was full */
+
+static inline bool _expires(fib_entry_t *entry)
+{
+    return (entry->lifetime != 0) && (entry->lifetime != FIB_LIFETIME_NO_EXPIRE);
+}
+
+static void _expiry_cb(void *arg)
+{
+    fib_table_t *table = arg;
+
+    table->expiry_pending = true;
+    if (table->expiry_pid != KERNEL_PID_UNDEF) {
+        msg_t msg = { .type = FIB_MSG_EXPIRE, .content = { .ptr = table } };
+
+        /* lookups leave expired entries to the thread, so keep telling it */
+        if (msg_try_send(&msg, table->expiry_pid) == 0) {
+            xtimer_set(&table->expiry_timer, EXPIRY_RETRY);
+        }
+    }
+}
+
+static void _expiry_init(fib_table_t *table)
+{
+    xtimer_remove(&table->expiry_timer);
+    table->expiry_timer.callback = _expiry_cb;
+    table->expiry_timer.arg = table;
+    table->expiry_head = EXPIRY_NIL;
+    table->expiry_pending = false;
+    table->expired = 0;
+}
+
+static void _expiry_arm(fib_table_t *table)
+{
+    uint64_t now, offset;
+
+    xtimer_remove(&table->expiry_timer);
+    if (table->expiry_head == EXPIRY_NIL) {
+        return;
+    }
+    now = xtimer_now64();
+    offset = table->data.entries[table->expiry_head].lifetime;
+    /* an entry expires once its lifetime is in the past */
+    offset = (offset < now) ? 0 : (offset - now + 1);
+    /* the timer fires early for far deadlines and is then armed again */
+    if (offset > EXPIRY_MAX_OFFSET) {
+        offset = EXPIRY_MAX_OFFSET;
+    }
+    xtimer_set(&table->expiry_timer, (uint32_t)offset);
+}
+
+static void _expiry_insert(fib_table_t *table, uint16_t idx)
+{
+    fib_entry_t *entries = table->data.entries;
+    uint16_t head = table->expiry_head, prev;
+
+    if (head == EXPIRY_NIL) {
+        entries[idx].expiry_prev = idx;
+        entries[idx].expiry_next = idx;
+        table->expiry_head = idx;
+        _expiry_arm(table);
+        return;
+    }
+    prev = entries[head].expiry_prev;
+    while ((entries[prev].lifetime > entries[idx].lifetime) && (prev != head)) {
+        prev = entries[prev].expiry_prev;
+    }
+    if (entries[prev].lifetime > entries[idx].lifetime) {
+        /* expires before the head, so becomes the new head */
+        prev = entries[head].expiry_prev;
+        table->expiry_head = idx;
+    }
+    entries[idx].expiry_prev = prev;
+    entries[idx].expiry_next = entries[prev].expiry_next;
+    entries[entries[prev].expiry_next].expiry_prev = idx;
+    entries[prev].expiry_next = idx;
+    if (table->expiry_head == idx) {
+        _expiry_arm(table);
+    }
+}
+
+static void _expiry_remove(fib_table_t *table, uint16_t idx)
+{
+    fib_entry_t *entries = table->data.entries;
+    uint16_t next = entries[idx].expiry_next;
+
+    if (next == idx) {
+        table->expiry_head = EXPIRY_NIL;
+    }
+    else {
+        entries[entries[idx].expiry_prev].expiry_next = next;
+        entries[next].expiry_prev = entries[idx].expiry_prev;
+        if (table->expiry_head == idx) {
+            table->expiry_head = next;
+        }
+    }
+    /* the timer is left armed for a removed head, it finds nothing to do */
+}
+
+static void _expire(fib_table_t *table)
+{
+    uint64_t now;
+
+    table->expiry_pending = false;
+    now = xtimer_now64();
+    while ((table->expiry_head != EXPIRY_NIL) &&
+           (table->data.entries[table->expiry_head].lifetime < now)) {
+        fib_remove(table, &table->data.entries[table->expiry_head]);
+        table->expired++;
+    }
+    _expiry_arm(table);
+}
+
+/* removes expired entries if the timer fired, call with the table locked */
+static inline void _expire_pending(fib_table_t *table)
+{
+    if (table->expiry_pending) {
+        _expire(table);
+    }
+}
+
+/* like _expire_pending(), but for read-only calls, so only if no thread
+ * takes care of it */
+static inline void _expire_pending_lookup(fib_table_t *table)
+{
+    if (table->expiry_pid == KERNEL_PID_UNDEF) {
+        _expire_pending(table);
+    }
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -80,13 +497,11 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now64();
-
-    size_t count = 0;
-    size_t prefix_size = 0;
-    size_t match_size = dst_size << 3;
-    int ret = -EHOSTUNREACH;
-    bool is_all_zeros_addr = true;
+    _lpm_key_t key = { dst, (uint8_t)dst_size };
+    unsigned key_bits = (dst_size + 1) << 3;
+    fib_entry_t *best;
+    uint16_t cur;
+    unsigned pos;
 
 #if ENABLE_DEBUG
     DEBUG("[fib_find_entry] dst =");
@@ -96,101 +511,70 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
-    for (size_t i = 0; i < dst_size; ++i) {
-        if (dst[i] != 0) {
-            is_all_zeros_addr = false;
-            break;
-        }
+    *entry_arr_size = 0;
+    if (dst_size > UNIVERSAL_ADDRESS_SIZE) {
+        return -EHOSTUNREACH;
     }
 
-    for (size_t i = 0; i < table->size; ++i) {
+    best = NULL;
+    pos = 0;
+    cur = table->lpm_root;
+    while (cur != LPM_NIL) {
+        fib_lpm_node_t *node = _lpm_node(table, cur);
+        _lpm_key_t nkey;
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
+        if (node->bits > key_bits) {
+            break;
+        }
+        nkey = _lpm_entry_key(table, node->key);
+        if ((pos = _lpm_key_match(&key, &nkey, pos, node->bits)) < node->bits) {
+            break;
+        }
+        if (!LPM_IS_BRANCH(cur)) {
+            fib_entry_t *match = NULL;
 
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
+            for (uint16_t id = cur; id != LPM_NIL; id = _lpm_node(table, id)->dup) {
+                fib_entry_t *entry = &table->data.entries[id >> 1];
 
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
+                if ((entry->global->address_size == dst_size) &&
+                    (memcmp(entry->global->address, dst, dst_size) == 0)) {
+                    entry_arr[0] = entry;
+                    *entry_arr_size = 1;
+                    return 1;
                 }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
+                if (match == NULL) {
+                    match = entry;
                 }
             }
+            best = match;
         }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
-
-            int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
-            /* If we found an exact match */
-            if ((ret_comp == UNIVERSAL_ADDRESS_EQUAL)
-                || (is_all_zeros_addr && (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS))) {
-                entry_arr[0] = &(table->data.entries[i]);
-                *entry_arr_size = 1;
-                /* we will not find a better one so we return */
-                return 1;
-            }
-            else {
-                /* we try to find the most fitting prefix */
-                if (ret_comp == UNIVERSAL_ADDRESS_MATCHING_PREFIX) {
-                    if (table->data.entries[i].global_flags & FIB_FLAG_NET_PREFIX_MASK) {
-                        /* we shift the most upper flag byte back to get the number of prefix bits */
-                        size_t global_prefix_len = (table->data.entries[i].global_flags
-                                                    & FIB_FLAG_NET_PREFIX_MASK) >> FIB_FLAG_NET_PREFIX_SHIFT;
-
-                        if ((match_size >= global_prefix_len) &&
-                            ((prefix_size == 0) || (match_size > prefix_size))) {
-                            entry_arr[0] = &(table->data.entries[i]);
-                            /* we could find a better one so we move on */
-                            ret = 0;
-
-                            prefix_size = match_size;
-                            count = 1;
-                        }
-                    }
-                 }
-                 else if (ret_comp == UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS) {
-                    /* we found the default gateway entry, e.g. ::/0 for IPv6
-                     * and we keep it only if there is no better one
-                     */
-                    if (prefix_size == 0) {
-                        entry_arr[0] = &(table->data.entries[i]);
-                        /* we could find a better one so we move on */
-                        ret = 0;
-                        count = 1;
-                    }
-                }
-                match_size = dst_size<<3;
-            }
+        if (node->bits == key_bits) {
+            break;
         }
+        cur = node->child[_lpm_key_bit(&key, node->bits)];
+    }
+
+    if (best == NULL) {
+        return -EHOSTUNREACH;
     }
 
 #if ENABLE_DEBUG
-    if (count > 0) {
-        DEBUG("[fib_find_entry] found prefix on interface %d:", entry_arr[0]->iface_id);
-        for (size_t i = 0; i < entry_arr[0]->global->address_size; i++) {
-            DEBUG(" %02x", entry_arr[0]->global->address[i]);
-        }
-        DEBUG("\n");
+    DEBUG("[fib_find_entry] found prefix on interface %d:", best->iface_id);
+    for (size_t i = 0; i < best->global->address_size; i++) {
+        DEBUG(" %02x", best->global->address[i]);
     }
+    DEBUG("\n");
 #endif
 
-    *entry_arr_size = count;
-    return ret;
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table of the entry
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -200,7 +584,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -210,12 +594,19 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
         return -ENOMEM;
     }
 
+    if ((container != entry->next_hop) || (next_hop_flags != entry->next_hop_flags)) {
+        table->version++;
+    }
     universal_address_rem(entry->next_hop);
     entry->next_hop = container;
     entry->next_hop_flags = next_hop_flags;
 
+    if (_expires(entry)) {
+        _expiry_remove(table, entry - table->data.entries);
+    }
     if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
         fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+        _expiry_insert(table, entry - table->data.entries);
     }
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
@@ -262,13 +653,22 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
+                    _expiry_insert(table, i);
                 }
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                _lpm_insert(table, i);
+                table->version++;
                 return 0;
             }
+
+            if (table->data.entries[i].global != NULL) {
+                /* keep unused entries out of the index */
+                universal_address_rem(table->data.entries[i].global);
+                table->data.entries[i].global = NULL;
+            }
         }
     }
 
@@ -278,13 +678,19 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table of the entry
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    if (_expires(entry)) {
+        _expiry_remove(table, entry - table->data.entries);
+    }
+
     if (entry->global != NULL) {
+        _lpm_remove(table, entry - table->data.entries);
         universal_address_rem(entry->global);
     }
 
@@ -299,6 +705,7 @@ static int fib_remove(fib_entry_t *entry)
 
     entry->iface_id = KERNEL_PID_UNDEF;
     entry->lifetime = 0;
+    table->version++;
 
     return 0;
 }
@@ -389,6 +796,7 @@ int fib_add_entry(fib_table_t *table,
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_add_entry]\n");
+    _expire_pending(table);
     size_t count = 1;
     fib_entry_t *entry[count];
 
@@ -402,7 +810,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -419,6 +827,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_update_entry]\n");
+    _expire_pending(table);
     size_t count = 1;
     fib_entry_t *entry[count];
     int ret = -ENOMEM;
@@ -432,7 +841,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -449,6 +858,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_remove_entry]\n");
+    _expire_pending(table);
     size_t count = 1;
     fib_entry_t *entry[count];
 
@@ -456,7 +866,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -472,11 +882,12 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_flush]\n");
+    _expire_pending(table);
 
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -490,6 +901,7 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_get_next_hop]\n");
+    _expire_pending_lookup(table);
     size_t count = 1;
     fib_entry_t *entry[count];
 
@@ -543,6 +955,7 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
                             size_t* dst_set_size)
 {
     mutex_lock(&(table->mtx_access));
+    _expire_pending_lookup(table);
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
@@ -594,7 +1007,11 @@ void fib_init(fib_table_t *table)
                sizeof(fib_sr_entry_t) * table->data.source_routes->entry_pool_size);
     }
     else {
+        assert(table->size < (LPM_NIL >> 1));
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        _lpm_init(table);
+        _expiry_init(table);
+        table->version++;
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -620,6 +1037,8 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+        _lpm_init(table);
+        _expiry_init(table);
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
@@ -654,6 +1073,7 @@ int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type
 int fib_get_num_used_entries(fib_table_t *table)
 {
     mutex_lock(&(table->mtx_access));
+    _expire_pending_lookup(table);
     size_t used_entries = 0;
 
     for (size_t i = 0; i < table->size; ++i) {
@@ -664,6 +1084,32 @@ int fib_get_num_used_entries(fib_table_t *table)
     return used_entries;
 }
 
+uint32_t fib_get_num_expired_entries(fib_table_t *table)
+{
+    mutex_lock(&(table->mtx_access));
+    _expire_pending_lookup(table);
+    uint32_t expired = table->expired;
+    mutex_unlock(&(table->mtx_access));
+    return expired;
+}
+
+void fib_set_expiry_thread(fib_table_t *table, kernel_pid_t pid)
+{
+    mutex_lock(&(table->mtx_access));
+    table->expiry_pid = pid;
+    mutex_unlock(&(table->mtx_access));
+}
+
+void fib_expire(fib_table_t *table)
+{
+    mutex_lock(&(table->mtx_access));
+    DEBUG("[fib_expire]\n");
+    if (table->table_type == FIB_TABLE_TYPE_SH) {
+        _expire(table);
+    }
+    mutex_unlock(&(table->mtx_access));
+}
+
 /* source route handling */
 int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_id,
                   uint32_t sr_flags, uint32_t sr_lifetime)
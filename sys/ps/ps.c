@@ -22,10 +22,6 @@
 #include "thread.h"
 #include "kernel_types.h"
 
-#ifdef MODULE_SCHEDSTATISTICS
-#include "xtimer.h"
-#endif
-
 #ifdef MODULE_TLSF
 #include "tlsf.h"
 #endif
@@ -41,7 +37,9 @@ const char *state_names[] = {
     [STATUS_SEND_BLOCKED] = "bl send",
     [STATUS_REPLY_BLOCKED] = "bl reply",
     [STATUS_FLAG_BLOCKED_ANY] = "bl anyfl",
-    [STATUS_FLAG_BLOCKED_ALL] = "bl allfl"
+    [STATUS_FLAG_BLOCKED_ALL] = "bl allfl",
+    [STATUS_MBOX_BLOCKED] = "bl mbox",
+    [STATUS_CHANNEL_BLOCKED] = "bl chan"
 };
 
 /**
@@ -63,7 +61,7 @@ void ps(void)
            "| stack ( used) | base       | current    "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime | switches"
+           "| runtime | cpu    | switches"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -71,6 +69,12 @@ void ps(void)
 #endif
            "state");
 
+#ifdef MODULE_SCHEDSTATISTICS
+    uint32_t now = schedstat_now();
+    /* CPU usage is taken over the current and the previous window */
+    uint32_t window = (now - schedstat_window_start) + schedstat_last_window;
+#endif
+
 #ifdef DEVELHELP
     int isr_usage = thread_arch_isr_stack_usage();
     void *isr_start = thread_arch_isr_stack_start();
@@ -97,8 +101,14 @@ void ps(void)
             overall_used += stacksz;
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-            double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now() * 100;
-            int switches = sched_pidlist[i].schedules;
+            schedstat *stat = &sched_pidlist[i];
+            unsigned long window_ticks = stat->window_ticks + stat->last_window_ticks;
+            if ((p == sched_active_thread) && stat->laststart) {
+                window_ticks += now - stat->laststart;
+            }
+            double runtime_ticks =  stat->runtime_ticks / (double) now * 100;
+            double cpu = window_ticks / (double) (window ? window : 1) * 100;
+            int switches = stat->schedules;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -109,7 +119,7 @@ void ps(void)
                    " | %5i (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %6.3f%% |  %8d"
+                   " | %6.3f%% | %5.1f%% |  %8d"
 #endif
                    "\n",
                    p->pid,
@@ -121,7 +131,7 @@ void ps(void)
                    , p->stack_size, stacksz, (void *)p->stack_start, (void *)p->sp
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   , runtime_ticks, switches
+                   , runtime_ticks, cpu, switches
 #endif
                   );
         }
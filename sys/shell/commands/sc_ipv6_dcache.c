@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the IPv6 destination cache
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/dcache.h"
+#include "net/gnrc/netif.h"
+
+static void _usage(char *cmd)
+{
+    printf("usage: * %s\n", cmd);
+    puts("         Lists the destination cache and its statistics.");
+    printf("       * %s flush\n", cmd);
+    puts("         Invalidates all entries.");
+}
+
+static void _list(void)
+{
+    char ipv6_str[IPV6_ADDR_MAX_STR_LEN];
+    char l2addr_str[3 * GNRC_IPV6_NC_L2_ADDR_MAX];
+    gnrc_ipv6_dcache_stats_t stats;
+
+    puts("Destination                     if  next hop                  MTU    source");
+    for (gnrc_ipv6_dcache_t *entry = gnrc_ipv6_dcache_get_next(NULL);
+         entry != NULL;
+         entry = gnrc_ipv6_dcache_get_next(entry)) {
+        printf("%-30s  %2" PRIkernel_pid "  ",
+               ipv6_addr_to_str(ipv6_str, &entry->dst, sizeof(ipv6_str)),
+               entry->iface);
+        printf("%-24s  %5u  ",
+               gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
+                                      entry->l2addr, entry->l2addr_len),
+               (unsigned)entry->mtu);
+        puts(ipv6_addr_to_str(ipv6_str, &entry->src, sizeof(ipv6_str)));
+    }
+
+    gnrc_ipv6_dcache_get_stats(&stats);
+    printf("hits: %" PRIu32 ", misses: %" PRIu32 ", flushes: %" PRIu32 "\n",
+           stats.hits, stats.misses, stats.flushes);
+}
+
+int _ipv6_dcache(int argc, char **argv)
+{
+    if (argc < 2) {
+        _list();
+        return 0;
+    }
+    if (strcmp("flush", argv[1]) == 0) {
+        gnrc_ipv6_dcache_flush();
+        puts("success: flushed destination cache");
+        return 0;
+    }
+
+    _usage(argv[0]);
+    return 1;
+}
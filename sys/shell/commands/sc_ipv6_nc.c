@@ -15,6 +15,7 @@
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -230,6 +231,27 @@ static int _ipv6_nc_reset(void)
     return 0;
 }
 
+static int _ipv6_nc_stats(void)
+{
+    static const char *states[] = { "UNMANAGED", "UNREACHABLE", "INCOMPLETE",
+                                    "STALE", "DELAY", "PROBE", "UNKNOWN",
+                                    "REACHABLE" };
+    gnrc_ipv6_nc_stats_t stats;
+
+    gnrc_ipv6_nc_get_stats(&stats);
+    printf("entries: %u of %u\n", (unsigned)stats.entries,
+           (unsigned)GNRC_IPV6_NC_SIZE);
+    for (unsigned i = 0; i <= GNRC_IPV6_NC_STATE_MASK; i++) {
+        if (stats.states[i] > 0) {
+            printf("  %-12s %u\n", states[i], (unsigned)stats.states[i]);
+        }
+    }
+    printf("evictions: %" PRIu32 "\n", stats.evictions);
+    printf("failed (cache full): %" PRIu32 "\n", stats.full);
+
+    return 0;
+}
+
 int _ipv6_nc_manage(int argc, char **argv)
 {
     if ((argc == 1) || (strcmp("list", argv[1]) == 0)) {
@@ -246,13 +268,17 @@ int _ipv6_nc_manage(int argc, char **argv)
         if (strcmp("reset", argv[1]) == 0) {
             return _ipv6_nc_reset();
         }
+        if (strcmp("stats", argv[1]) == 0) {
+            return _ipv6_nc_stats();
+        }
     }
 
     printf("usage: %s [list]\n"
            "   or: %s add [<iface pid>] <ipv6_addr> <l2_addr>\n"
            "      * <iface pid> is optional if only one interface exists.\n"
            "   or: %s del <ipv6_addr>\n"
-           "   or: %s reset\n", argv[0], argv[0], argv[0], argv[0]);
+           "   or: %s reset\n"
+           "   or: %s stats\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
     return 1;
 }
 
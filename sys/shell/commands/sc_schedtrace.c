@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the scheduler trace ring
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "irq.h"
+#include "sched.h"
+
+static const char *_reasons[] = {
+    [SCHEDSTAT_TRACE_SWITCH] = "switch",
+    [SCHEDSTAT_TRACE_IRQ] = "irq",
+    [SCHEDSTAT_TRACE_MSG_SEND] = "bl send",
+    [SCHEDSTAT_TRACE_MSG_RECEIVE] = "bl rx",
+    [SCHEDSTAT_TRACE_MSG_REPLY] = "bl reply",
+};
+
+static void _usage(const char *cmd)
+{
+#ifdef CPU_NATIVE
+    printf("usage: %s [dump <file>]\n", cmd);
+#else
+    printf("usage: %s\n", cmd);
+#endif
+}
+
+static void _print(void)
+{
+    /* too large for the shell thread's stack */
+    static schedstat_trace_t entries[SCHEDSTAT_TRACE_SIZE];
+
+    /* take a snapshot, printing would add entries to the ring */
+    unsigned state = irq_disable();
+    unsigned count = schedstat_trace_count;
+    memcpy(entries, schedstat_trace_ring, sizeof(entries));
+    irq_restore(state);
+
+    unsigned first = (count > SCHEDSTAT_TRACE_SIZE) ?
+                     (count - SCHEDSTAT_TRACE_SIZE) : 0;
+
+    printf("%u events, showing the last %u (%lu ticks/s)\n", count,
+           count - first, (unsigned long)SCHEDSTAT_HZ);
+    puts("      time | reason   | from |   to");
+    for (unsigned i = first; i < count; i++) {
+        schedstat_trace_t *e = &entries[i & (SCHEDSTAT_TRACE_SIZE - 1)];
+        printf("%10" PRIu32 " | %-8s | %4" PRIkernel_pid " | %4" PRIkernel_pid "\n",
+               e->time, _reasons[e->reason], e->from, e->to);
+    }
+}
+
+int _schedtrace_handler(int argc, char **argv)
+{
+    if (argc == 1) {
+        _print();
+        return 0;
+    }
+#ifdef CPU_NATIVE
+    if ((argc == 3) && (strcmp(argv[1], "dump") == 0)) {
+        int res = schedstat_trace_dump(argv[2]);
+        if (res < 0) {
+            printf("error: unable to write %s\n", argv[2]);
+            return 1;
+        }
+        printf("wrote %d events to %s\n", res, argv[2]);
+        return 0;
+    }
+#endif
+    _usage(argv[0]);
+    return 1;
+}
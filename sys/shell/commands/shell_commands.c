@@ -37,6 +37,10 @@ extern int _heap_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+extern int _schedtrace_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT11
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -98,6 +102,10 @@ extern int _ipv6_nc_manage(int argc, char **argv);
 extern int _ipv6_nc_routers(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_IPV6_DCACHE
+extern int _ipv6_dcache(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_IPV6_WHITELIST
 extern int _whitelist(int argc, char **argv);
 #endif
@@ -144,6 +152,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_SCHEDSTATISTICS_TRACE
+    {"schedtrace", "Prints the scheduler trace ring", _schedtrace_handler},
+#endif
 #ifdef MODULE_SHT11
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
@@ -190,6 +201,9 @@ const shell_command_t _shell_command_list[] = {
     {"ncache", "manage neighbor cache by hand", _ipv6_nc_manage },
     {"routers", "IPv6 default router list", _ipv6_nc_routers },
 #endif
+#ifdef MODULE_GNRC_IPV6_DCACHE
+    {"dcache", "IPv6 destination cache ('dcache [flush]')", _ipv6_dcache },
+#endif
 #ifdef MODULE_GNRC_IPV6_WHITELIST
     {"whitelist", "whitelists an address for receival ('whitelist [add|del|help]')", _whitelist },
 #endif
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -41,12 +43,41 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+    if (n > avail) {
+        n = avail;
+    }
+
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t first = rb->size - pos;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(dst, &rb->buf[pos], first);
+    if (n > first) {
+        memcpy(dst + first, rb->buf, n - first);
     }
-    return (n - tmp);
+    rb->reads += n;
+
+    return n;
+}
+
+size_t tsrb_get_span(tsrb_t *rb, char **span)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t n = tsrb_avail(rb);
+    if (n > (rb->size - pos)) {
+        n = rb->size - pos;
+    }
+
+    *span = &rb->buf[pos];
+    return n;
+}
+
+void tsrb_drop(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_avail(rb));
+    rb->reads += n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +93,39 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t free = tsrb_free(rb);
+    if (n > free) {
+        n = free;
     }
-    return (n - tmp);
+
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t first = rb->size - pos;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(&rb->buf[pos], src, first);
+    if (n > first) {
+        memcpy(rb->buf, src + first, n - first);
+    }
+    rb->writes += n;
+
+    return n;
+}
+
+size_t tsrb_peek_span(tsrb_t *rb, char **span)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t n = tsrb_free(rb);
+    if (n > (rb->size - pos)) {
+        n = rb->size - pos;
+    }
+
+    *span = &rb->buf[pos];
+    return n;
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    rb->writes += n;
 }
@@ -25,6 +25,7 @@
 #include "net/gnrc/ipv6.h"
 #endif
 #endif
+#include "bitarithm.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -46,6 +47,37 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES >= 0xffff
+#error "UNIVERSAL_ADDRESS_MAX_ENTRIES must be less than 65535"
+#endif
+
+/**
+ * @brief Number of hash buckets, a power of two
+ */
+#ifndef UNIVERSAL_ADDRESS_BUCKETS
+/* about two to four containers per bucket if the table is full */
+#   if UNIVERSAL_ADDRESS_MAX_ENTRIES >= 2048
+#       define UNIVERSAL_ADDRESS_BUCKETS    (1024)
+#   elif UNIVERSAL_ADDRESS_MAX_ENTRIES >= 512
+#       define UNIVERSAL_ADDRESS_BUCKETS    (256)
+#   elif UNIVERSAL_ADDRESS_MAX_ENTRIES >= 128
+#       define UNIVERSAL_ADDRESS_BUCKETS    (64)
+#   elif UNIVERSAL_ADDRESS_MAX_ENTRIES >= 32
+#       define UNIVERSAL_ADDRESS_BUCKETS    (16)
+#   else
+#       define UNIVERSAL_ADDRESS_BUCKETS    (4)
+#   endif
+#endif
+
+#if (UNIVERSAL_ADDRESS_BUCKETS & (UNIVERSAL_ADDRESS_BUCKETS - 1)) != 0
+#error "UNIVERSAL_ADDRESS_BUCKETS must be a power of 2"
+#endif
+
+/**
+ * @brief marks the end of a bucket or the free list
+ */
+#define UA_NIL  (0xffff)
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,46 +88,129 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief first container of every hash bucket, chained by
+ *        universal_address_container_t::next
+ */
+static uint16_t universal_address_buckets[UNIVERSAL_ADDRESS_BUCKETS];
+
+/**
+ * @brief first unused container, chained by universal_address_container_t::next
+ */
+static uint16_t universal_address_free;
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
 /**
- * @brief finds the universal address container for the given address
- *
- * @param[in] addr       pointer to the address
- * @param[in] addr_size  the number of bytes required for the address entry
- *
- * @return pointer to the universal_address_container_t containing the address on success
- *         NULL if the address could not be inserted
+ * @brief hashes an address of the given size to its bucket
  */
-static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
+static uint16_t *universal_address_bucket(const uint8_t *addr, size_t addr_size)
 {
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    uint32_t hash = addr_size * 0x9e3779b1;
+    size_t i = 0;
+
+    for (; (i + sizeof(uint32_t)) <= addr_size; i += sizeof(uint32_t)) {
+        uint32_t word;
+
+        memcpy(&word, addr + i, sizeof(word));
+        hash = (hash ^ word) * 0x9e3779b1;
+        hash ^= hash >> 15;
+    }
+    for (; i < addr_size; i++) {
+        hash = (hash ^ addr[i]) * 0x01000193;
+    }
+    hash ^= hash >> 16;
+
+    return &universal_address_buckets[hash & (UNIVERSAL_ADDRESS_BUCKETS - 1)];
+}
+
+/**
+ * @brief returns the index of the first byte in which a and b differ,
+ *        or size if they are equal
+ */
+static size_t universal_address_first_diff(const uint8_t *a, const uint8_t *b,
+                                           size_t size)
+{
+    size_t i = 0;
+
+    for (; (i + sizeof(uint32_t)) <= size; i += sizeof(uint32_t)) {
+        uint32_t word_a, word_b;
+
+        memcpy(&word_a, a + i, sizeof(word_a));
+        memcpy(&word_b, b + i, sizeof(word_b));
+        if (word_a != word_b) {
+            break;
         }
     }
+    for (; (i < size) && (a[i] == b[i]); i++) {}
 
-    return NULL;
+    return i;
+}
+
+/**
+ * @brief returns the number of bytes up to and including the last non-zero
+ *        byte, i.e. 0 if all bytes are `0`
+ */
+static size_t universal_address_used_len(const uint8_t *addr, size_t size)
+{
+    while (size >= sizeof(uint32_t)) {
+        uint32_t word;
+
+        memcpy(&word, addr + size - sizeof(word), sizeof(word));
+        if (word != 0) {
+            break;
+        }
+        size -= sizeof(word);
+    }
+    while ((size > 0) && (addr[size - 1] == 0)) {
+        size--;
+    }
+
+    return size;
 }
 
 /**
- * @brief finds the next empty or unused universal address containers
+ * @brief puts all containers back to the free list and empties the buckets
+ */
+static void universal_address_clear(void)
+{
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_BUCKETS; ++i) {
+        universal_address_buckets[i] = UA_NIL;
+    }
+
+    universal_address_free = UA_NIL;
+    for (size_t i = UNIVERSAL_ADDRESS_MAX_ENTRIES; i > 0; --i) {
+        universal_address_table[i - 1].use_count = 0;
+        universal_address_table[i - 1].next = universal_address_free;
+        universal_address_free = i - 1;
+    }
+
+    universal_address_table_filled = 0;
+}
+
+/**
+ * @brief finds the universal address container for the given address
+ *
+ * @param[in] bucket     the hash bucket of the address
+ * @param[in] addr       pointer to the address
+ * @param[in] addr_size  the number of bytes required for the address entry
  *
- * @return pointer to the next free/unused universal_address_container_t
- *         or NULL if no memory is left in universal_address_table
+ * @return pointer to the universal_address_container_t containing the address on success
+ *         NULL if the address could not be inserted
  */
-static universal_address_container_t *universal_address_get_next_unused_entry(void)
+static universal_address_container_t *universal_address_find_entry(uint16_t *bucket,
+                                                                   uint8_t *addr,
+                                                                   size_t addr_size)
 {
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
+    for (uint16_t i = *bucket; i != UA_NIL; i = universal_address_table[i].next) {
+        universal_address_container_t *entry = &universal_address_table[i];
+
+        if ((entry->address_size == addr_size) &&
+            (universal_address_first_diff(entry->address, addr, addr_size) == addr_size)) {
+            return entry;
         }
     }
 
@@ -104,41 +219,42 @@ static universal_address_container_t *universal_address_get_next_unused_entry(vo
 
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
 {
+    if (addr_size > UNIVERSAL_ADDRESS_SIZE) {
+        return NULL;
+    }
+
     mutex_lock(&mtx_access);
-    universal_address_container_t *pEntry = universal_address_find_entry(addr, addr_size);
+    uint16_t *bucket = universal_address_bucket(addr, addr_size);
+    universal_address_container_t *pEntry = universal_address_find_entry(bucket, addr,
+                                                                         addr_size);
 
     if (pEntry == NULL) {
-        /* look for a free entry */
-        pEntry = universal_address_get_next_unused_entry();
-
-        if (pEntry == NULL) {
+        /* take a free entry */
+        if (universal_address_free == UA_NIL) {
             mutex_unlock(&mtx_access);
             /* no free room */
             return NULL;
         }
 
-        /* look if the former memory has distinct size */
-        if (pEntry->address_size != addr_size) {
-            /* clean the address */
-            memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
-
-            /* set the used bytes */
-            pEntry->address_size = addr_size;
-            pEntry->use_count = 0;
-        }
+        pEntry = &universal_address_table[universal_address_free];
+        universal_address_free = pEntry->next;
 
-        /* copy the address */
+        /* clean the address and copy the new one */
+        memset(pEntry->address, 0, UNIVERSAL_ADDRESS_SIZE);
         memcpy((pEntry->address), addr, addr_size);
-    }
+        pEntry->address_size = addr_size;
+        pEntry->use_count = 0;
 
-    pEntry->use_count++;
+        pEntry->next = *bucket;
+        *bucket = pEntry - universal_address_table;
 
-    if (pEntry->use_count == 1) {
         DEBUG("[universal_address_add] universal_address_table_filled: %d\n", \
               (int)universal_address_table_filled);
         universal_address_table_filled++;
     }
 
+    pEntry->use_count++;
+
     mutex_unlock(&mtx_access);
     return pEntry;
 }
@@ -148,12 +264,22 @@ void universal_address_rem(universal_address_container_t *entry)
     mutex_lock(&mtx_access);
     DEBUG("[universal_address_rem] entry: %p\n", (void *)entry);
 
-    /* we do not delete anything on remove */
     if (entry != NULL) {
         if (entry->use_count != 0) {
             entry->use_count--;
 
             if (entry->use_count == 0) {
+                /* unlink it from its bucket and return it to the free list */
+                uint16_t idx = entry - universal_address_table;
+                uint16_t *pos = universal_address_bucket(entry->address,
+                                                         entry->address_size);
+
+                while (*pos != idx) {
+                    pos = &universal_address_table[*pos].next;
+                }
+                *pos = entry->next;
+                entry->next = universal_address_free;
+                universal_address_free = idx;
                 universal_address_table_filled--;
             }
         }
@@ -196,45 +322,22 @@ int universal_address_compare(universal_address_container_t *entry,
         return ret;
     }
 
-    /* compare up to fist distinct byte, pretty clumsy method for now */
-    int idx = -1;
-    bool test_all_zeros = true;
-    for (size_t i = 0; i < entry->address_size; i++) {
-        if ((idx == -1) && (entry->address[i] != addr[i])) {
-            idx = i;
-        }
-        if (test_all_zeros) {
-            test_all_zeros = (entry->address[i] == 0);
-        }
-        if ((idx != -1) && !test_all_zeros) {
-            break;
-        }
-    }
-
     /* if the address is all 0 its a default route address */
-    if (test_all_zeros) {
+    if (universal_address_used_len(entry->address, entry->address_size) == 0) {
         *addr_size_in_bits = 0;
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS;
     }
 
     /* if we have no distinct bytes the addresses are equal */
-    if (idx == -1) {
+    size_t idx = universal_address_first_diff(entry->address, addr, entry->address_size);
+    if (idx == entry->address_size) {
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_EQUAL;
     }
 
-    /* count equal bits */
-    uint8_t xor = entry->address[idx]^addr[idx];
-    int8_t j = 7;
-    for ( ; j > 0; --j) {
-        if ((xor >> j) & 0x01) {
-            break;
-        }
-    }
-
     /* get the total number of matching bits */
-    *addr_size_in_bits = (idx << 3) + j;
+    *addr_size_in_bits = (idx << 3) + bitarithm_msb(entry->address[idx] ^ addr[idx]);
     ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
 
     mutex_unlock(&mtx_access);
@@ -252,36 +355,27 @@ int universal_address_compare_prefix(universal_address_container_t *entry,
         return ret;
     }
 
-    /* Get the index of the first trailing `0` */
-    int i = 0;
-    for (i = entry->address_size-1; i >= 0; --i) {
-        if (prefix[i] != 0) {
-            break;
-        }
-    }
+    /* Get the number of bytes up to the trailing `0`s */
+    size_t len = universal_address_used_len(prefix, entry->address_size);
 
-    if (memcmp(entry->address, prefix, i) == 0) {
+    if (len == 0) {
+        /* the all `0` prefix matches any address */
+        ret = (universal_address_used_len(entry->address, entry->address_size) == 0) ?
+              UNIVERSAL_ADDRESS_EQUAL : UNIVERSAL_ADDRESS_MATCHING_PREFIX;
+    }
+    else if (universal_address_first_diff(entry->address, prefix, len - 1) == (len - 1)) {
         /* if the bytes-1 equals we check the bits of the lowest byte */
-        uint8_t bitmask = 0x00;
+        size_t i = len - 1;
         /* get a bitmask for the trailing 0b */
-        for (uint8_t j = 0; j < 8; ++j) {
-            if ((prefix[i] >> j) & 0x01) {
-                bitmask = 0xff << j;
-                break;
-            }
-        }
+        uint8_t bitmask = 0xff << bitarithm_lsb(prefix[i]);
 
         if ((entry->address[i] & bitmask) == (prefix[i] & bitmask)) {
             ret = entry->address[i] != prefix[i];
-            if (ret == UNIVERSAL_ADDRESS_EQUAL) {
-                /* check if the remaining bits from entry are significant */
-                i++;
-                for ( ; i < entry->address_size; ++i) {
-                    if (entry->address[i] != 0) {
-                        ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
-                        break;
-                    }
-                }
+            /* check if the remaining bits from entry are significant */
+            if ((ret == UNIVERSAL_ADDRESS_EQUAL) &&
+                (universal_address_used_len(entry->address + len,
+                                            entry->address_size - len) != 0)) {
+                ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
             }
         }
     }
@@ -295,10 +389,10 @@ void universal_address_init(void)
     mutex_lock(&mtx_access);
 
     for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
         universal_address_table[i].address_size = 0;
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
+    universal_address_clear();
 
     mutex_unlock(&mtx_access);
 }
@@ -306,12 +400,7 @@ void universal_address_init(void)
 void universal_address_reset(void)
 {
     mutex_lock(&mtx_access);
-
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
-    }
-
-    universal_address_table_filled = 0;
+    universal_address_clear();
     mutex_unlock(&mtx_access);
 }
 
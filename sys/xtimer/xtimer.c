@@ -32,6 +32,21 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#ifdef MODULE_XTIMER_STATS
+xtimer_stats_t xtimer_stats;
+#endif
+
+/* Two copies of the coarse time, _coarse_idx selects the current one. The
+ * writer fills the other copy before switching, so readers never see a torn
+ * 64bit value, even when interrupting the writer. */
+static volatile uint64_t _coarse_now[2];
+static volatile unsigned _coarse_idx;
+
+#if XTIMER_COARSE_TICK
+static void _coarse_tick(void *arg);
+static xtimer_t _coarse_timer = { .callback = _coarse_tick };
+#endif
+
 static void _callback_unlock_mutex(void* arg)
 {
     mutex_t *mutex = (mutex_t *) arg;
@@ -145,12 +160,61 @@ void xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t t
     xtimer_set(timer, offset);
 }
 
+void xtimer_set_msg_slack(xtimer_t *timer, uint32_t offset, uint32_t slack,
+                          msg_t *msg, kernel_pid_t target_pid)
+{
+    _setup_msg(timer, msg, target_pid);
+    xtimer_set_slack(timer, offset, slack);
+}
+
 void xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid)
 {
     _setup_msg(timer, msg, target_pid);
     _xtimer_set64(timer, offset, offset >> 32);
 }
 
+void xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    if (!timer->callback) {
+        return;
+    }
+
+    if (offset < XTIMER_BACKOFF) {
+        xtimer_set(timer, offset);
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    uint32_t target = xtimer_now() + offset;
+    uint32_t limit = target + slack;
+
+    if (limit < target) {
+        /* don't round across the 32bit overflow */
+        limit = UINT32_MAX;
+    }
+
+    /* Clear all bits of the latest allowed target below the highest bit
+     * that differs from the earliest one. The result is still within the
+     * window, and windows that overlap mostly round to the same value. */
+    uint32_t mask = target ^ limit;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    mask >>= 1;
+
+#ifdef MODULE_XTIMER_STATS
+    xtimer_stats.slack_set++;
+    if ((limit & ~mask) != target) {
+        xtimer_stats.slack_moved++;
+    }
+#endif
+
+    _xtimer_set_absolute(timer, limit & ~mask);
+}
+
 static void _callback_wakeup(void* arg)
 {
     thread_wakeup((kernel_pid_t)((intptr_t)arg));
@@ -180,6 +244,44 @@ void xtimer_now_timex(timex_t *out)
     out->microseconds = now - (out->seconds * SEC_IN_USEC);
 }
 
+uint64_t xtimer_now64_coarse(void)
+{
+    unsigned idx;
+    uint64_t now;
+
+    do {
+        idx = _coarse_idx;
+        now = _coarse_now[idx & 1];
+    } while (idx != _coarse_idx);
+
+    return now;
+}
+
+void _xtimer_coarse_update(uint64_t now)
+{
+    unsigned idx = _coarse_idx + 1;
+
+    _coarse_now[idx & 1] = now;
+    _coarse_idx = idx;
+}
+
+#if XTIMER_COARSE_TICK
+static void _coarse_tick(void *arg)
+{
+    (void)arg;
+    /* the value itself is updated by the xtimer ISR */
+    xtimer_set(&_coarse_timer, XTIMER_COARSE_TICK);
+}
+#endif
+
+void _xtimer_coarse_init(void)
+{
+    _xtimer_coarse_update(xtimer_now64());
+#if XTIMER_COARSE_TICK
+    xtimer_set(&_coarse_timer, XTIMER_COARSE_TICK);
+#endif
+}
+
 /* Prepares the message to trigger the timeout.
  * Additionally, the xtimer_t struct gets initialized.
  */
@@ -24,6 +24,8 @@
 #include "xtimer.h"
 #include "irq.h"
 
+#ifndef MODULE_XTIMER_WHEEL
+
 /* WARNING! enabling this will have side effects and can lead to timer underflows. */
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -31,6 +33,7 @@
 static volatile int _in_handler = 0;
 
 static volatile uint32_t _long_cnt = 0;
+static volatile uint32_t _now_seq = 0;
 #if XTIMER_MASK
 volatile uint32_t _xtimer_high_cnt = 0;
 #endif
@@ -73,21 +76,24 @@ void xtimer_init(void)
 
     /* register initial overflow tick */
     _lltimer_set(0xFFFFFFFF);
+
+    _xtimer_coarse_init();
 }
 
 static void _xtimer_now64(uint32_t *short_term, uint32_t *long_term)
 {
-    uint32_t before, after, long_value;
+    uint32_t seq, short_value, long_value;
 
-    /* loop to cope with possible overflow of xtimer_now() */
+    /* _now_seq changes whenever the ISR advances the period counters, so
+     * if it didn't change while reading, both values belong together.
+     * This needs a single low-level timer read and no IRQ lock. */
     do {
-        before = xtimer_now();
+        seq = _now_seq;
         long_value = _long_cnt;
-        after = xtimer_now();
-
-    } while(before > after);
+        short_value = xtimer_now();
+    } while (seq != _now_seq);
 
-    *short_term = after;
+    *short_term = short_value;
     *long_term = long_value;
 }
 
@@ -423,6 +429,9 @@ static void _next_period(void)
     _long_cnt++;
 #endif
 
+    /* let xtimer_now64() readers know they have to retry */
+    _now_seq++;
+
     /* swap overflow list to current timer list */
     timer_list_head = overflow_list_head;
     overflow_list_head = NULL;
@@ -437,6 +446,9 @@ static void _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
+#ifdef MODULE_XTIMER_STATS
+    uint32_t fired = xtimer_stats.fired;
+#endif
 
     _in_handler = 1;
 
@@ -484,6 +496,9 @@ overflow:
 
         /* fire timer */
         _shoot(timer);
+#ifdef MODULE_XTIMER_STATS
+        xtimer_stats.fired++;
+#endif
     }
 
     /* possibly executing all callbacks took enough
@@ -530,8 +545,17 @@ overflow:
         }
     }
 
+#ifdef MODULE_XTIMER_STATS
+    if (xtimer_stats.fired != fired) {
+        xtimer_stats.wakeups++;
+    }
+#endif
+
+    _xtimer_coarse_update(xtimer_now64());
+
     _in_handler = 0;
 
     /* set low level timer */
     _lltimer_set(next_target);
 }
+#endif /* MODULE_XTIMER_WHEEL */
@@ -0,0 +1,507 @@
+/**
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer core functionality, hierarchical timing wheel backend
+ *
+ * Replaces xtimer_core.c if the `xtimer_wheel` module is used.
+ *
+ * The wheel keeps its own notion of the current time (_wheel_time), which
+ * is only advanced by the timer callback and lags behind the real time in
+ * between. A timer is filed on the highest level on which its target differs
+ * from the wheel time, in the slot given by the target's digit on that level.
+ * Timers on the first level are due when the wheel time reaches their slot,
+ * timers on higher levels are moved down when the wheel time reaches theirs.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "bitarithm.h"
+#include "xtimer.h"
+#include "irq.h"
+
+#ifdef MODULE_XTIMER_WHEEL
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define WHEEL_SLOTS     (1U << XTIMER_WHEEL_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_SPAN_BITS (XTIMER_WHEEL_LEVELS * XTIMER_WHEEL_BITS)
+
+static volatile int _in_handler = 0;
+
+static volatile uint32_t _long_cnt = 0;
+static volatile uint32_t _now_seq = 0;
+#if XTIMER_MASK
+volatile uint32_t _xtimer_high_cnt = 0;
+#endif
+
+/**
+ * @brief last low-level timer value seen, to detect its overflows
+ */
+static uint32_t _last_lltimer;
+
+/**
+ * @brief time up to which the wheel has been processed
+ */
+static uint64_t _wheel_time;
+
+/**
+ * @brief time the low-level timer is currently set for
+ */
+static uint64_t _armed_time;
+
+static xtimer_t *_wheel[XTIMER_WHEEL_LEVELS][WHEEL_SLOTS];
+static uint16_t _occupied[XTIMER_WHEEL_LEVELS];
+static xtimer_t *_far_list;
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline int _is_set(xtimer_t *timer)
+{
+    return (timer->target || timer->long_target);
+}
+
+static inline void xtimer_spin_until(uint32_t target) {
+#if XTIMER_MASK
+    target = _xtimer_lltimer_mask(target);
+#endif
+    while (_xtimer_lltimer_now() > target);
+    while (_xtimer_lltimer_now() < target);
+}
+
+static inline void _lltimer_set(uint32_t target)
+{
+    if (_in_handler) {
+        return;
+    }
+    DEBUG("_lltimer_set(): setting %" PRIu32 "\n", _xtimer_lltimer_mask(target));
+#ifdef XTIMER_SHIFT
+    target = XTIMER_USEC_TO_TICKS(target);
+    if (!target) {
+        target++;
+    }
+#endif
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN, _xtimer_lltimer_mask(target));
+}
+
+static void _xtimer_now64(uint32_t *short_term, uint32_t *long_term)
+{
+    uint32_t seq, short_value, long_value;
+
+    /* _now_seq changes whenever the ISR advances the period counters, so
+     * if it didn't change while reading, both values belong together.
+     * This needs a single low-level timer read and no IRQ lock. */
+    do {
+        seq = _now_seq;
+        long_value = _long_cnt;
+        short_value = xtimer_now();
+    } while (seq != _now_seq);
+
+    *short_term = short_value;
+    *long_term = long_value;
+}
+
+uint64_t xtimer_now64(void)
+{
+    uint32_t short_term, long_term;
+    _xtimer_now64(&short_term, &long_term);
+
+    return ((uint64_t)long_term<<32) + short_term;
+}
+
+/**
+ * @brief advance to the next low-level timer period
+ */
+static void _next_period(void)
+{
+#if XTIMER_MASK
+    /* advance <32bit mask register */
+    _xtimer_high_cnt += ~XTIMER_MASK_SHIFTED + 1;
+    if (_xtimer_high_cnt == 0) {
+        /* high_cnt overflowed, so advance >32bit counter */
+        _long_cnt++;
+    }
+#else
+    /* advance >32bit counter */
+    _long_cnt++;
+#endif
+
+    /* let xtimer_now64() readers know they have to retry */
+    _now_seq++;
+}
+
+/**
+ * @brief get the current 64bit time, must be called with interrupts disabled
+ *
+ * Also accounts for overflows of the low-level timer.
+ */
+static uint64_t _now64(void)
+{
+    uint32_t now = _xtimer_lltimer_now();
+
+    if (now < _last_lltimer) {
+        _next_period();
+    }
+    _last_lltimer = now;
+
+#if XTIMER_MASK
+    now |= _xtimer_high_cnt;
+#endif
+    return ((uint64_t)_long_cnt << 32) | now;
+}
+
+/**
+ * @brief next half or end of a low-level timer period after @p now
+ *
+ * The callback runs at least at these points, so that overflows of the
+ * low-level timer are noticed and never more than one goes unnoticed.
+ */
+static inline uint64_t _next_checkpoint(uint64_t now)
+{
+    return (now | (_xtimer_lltimer_mask(0xFFFFFFFF) >> 1)) + 1;
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_USEC_TO_TICKS(1000000ul), _periph_timer_callback, NULL);
+
+    _last_lltimer = _xtimer_lltimer_now();
+    _armed_time = _next_checkpoint(_last_lltimer);
+
+    /* register initial overflow check */
+    _lltimer_set((uint32_t)_armed_time - XTIMER_OVERHEAD);
+
+    _xtimer_coarse_init();
+}
+
+static inline uint64_t _target64(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline unsigned _digit(uint64_t time, unsigned level)
+{
+    return (time >> (level * XTIMER_WHEEL_BITS)) & WHEEL_SLOT_MASK;
+}
+
+static void _link(xtimer_t **head, xtimer_t *timer)
+{
+    timer->next = *head;
+    if (*head) {
+        (*head)->prev_next = &timer->next;
+    }
+    timer->prev_next = head;
+    *head = timer;
+}
+
+static void _unlink(xtimer_t *timer)
+{
+    xtimer_t **head = timer->prev_next;
+
+    *head = timer->next;
+    if (timer->next) {
+        timer->next->prev_next = head;
+    }
+
+    /* mark the slot empty if this was its last timer */
+    if (!*head && (head >= &_wheel[0][0]) &&
+        (head < &_wheel[0][0] + (XTIMER_WHEEL_LEVELS * WHEEL_SLOTS))) {
+        unsigned index = head - &_wheel[0][0];
+        _occupied[index / WHEEL_SLOTS] &= ~(1U << (index % WHEEL_SLOTS));
+    }
+}
+
+static void _wheel_add(xtimer_t *timer)
+{
+    uint64_t target = _target64(timer);
+
+    if (target < _wheel_time) {
+        /* already due, will be fired with the current slot */
+        target = _wheel_time;
+    }
+
+    uint64_t diff = target ^ _wheel_time;
+
+    if (diff >> WHEEL_SPAN_BITS) {
+        _link(&_far_list, timer);
+        return;
+    }
+
+    /* file the timer on the highest level its target differs on */
+    unsigned level = 0;
+    while (diff >> ((level + 1) * XTIMER_WHEEL_BITS)) {
+        level++;
+    }
+
+    unsigned slot = _digit(target, level);
+    _link(&_wheel[level][slot], timer);
+    _occupied[level] |= (1U << slot);
+}
+
+/**
+ * @brief get the time of the next event of the wheel
+ *
+ * @param[out] level    level of the event, XTIMER_WHEEL_LEVELS for the far
+ *                      list
+ *
+ * @return  time of the next event, UINT64_MAX if there is none
+ */
+static uint64_t _wheel_next(unsigned *level)
+{
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        unsigned shift = l * XTIMER_WHEEL_BITS;
+        unsigned digit = _digit(_wheel_time, l);
+        /* the current slot can only hold timers on the first level, on the
+         * others they have already been moved down */
+        uint32_t pending = _occupied[l] & ~(((uint32_t)(l ? 2 : 1) << digit) - 1);
+
+        if (pending) {
+            uint64_t base = (_wheel_time >> (shift + XTIMER_WHEEL_BITS))
+                            << (shift + XTIMER_WHEEL_BITS);
+            *level = l;
+            return base | ((uint64_t)bitarithm_lsb(pending) << shift);
+        }
+    }
+
+    if (_far_list) {
+        *level = XTIMER_WHEEL_LEVELS;
+        return ((_wheel_time >> WHEEL_SPAN_BITS) + 1) << WHEEL_SPAN_BITS;
+    }
+
+    return UINT64_MAX;
+}
+
+/**
+ * @brief process all events of the wheel up to @p now
+ */
+static void _wheel_advance(uint64_t now)
+{
+    uint64_t next;
+    unsigned level;
+
+    while ((next = _wheel_next(&level)) <= now) {
+        _wheel_time = next;
+
+        if (level == 0) {
+            xtimer_t **slot = &_wheel[0][_digit(next, 0)];
+            xtimer_t *timer;
+
+            /* callbacks may set and remove timers, so take one by one */
+            while ((timer = *slot)) {
+                _unlink(timer);
+
+                /* make sure timer is recognized as being already fired */
+                timer->target = 0;
+                timer->long_target = 0;
+
+                timer->callback(timer->arg);
+#ifdef MODULE_XTIMER_STATS
+                xtimer_stats.fired++;
+#endif
+            }
+        }
+        else {
+            xtimer_t **slot = (level < XTIMER_WHEEL_LEVELS)
+                              ? &_wheel[level][_digit(next, level)]
+                              : &_far_list;
+            xtimer_t *list = *slot;
+
+            /* move the timers down, relative to the new wheel time */
+            *slot = NULL;
+            if (level < XTIMER_WHEEL_LEVELS) {
+                _occupied[level] &= ~(1U << _digit(next, level));
+            }
+            while (list) {
+                xtimer_t *timer = list;
+                list = list->next;
+                _wheel_add(timer);
+            }
+        }
+    }
+}
+
+/**
+ * @brief set the low-level timer earlier if an added timer requires it
+ */
+static void _rearm(uint64_t now)
+{
+    unsigned level;
+    uint64_t next = _wheel_next(&level);
+
+    if (_in_handler || (next >= _armed_time)) {
+        return;
+    }
+
+    /* the wheel time lags behind, so moving a timer down can be overdue */
+    if (next < now + XTIMER_BACKOFF) {
+        next = now + XTIMER_BACKOFF;
+    }
+
+    if (next < _armed_time) {
+        _armed_time = next;
+        _lltimer_set((uint32_t)next - XTIMER_OVERHEAD);
+    }
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+static void _add(xtimer_t *timer, uint64_t target, uint64_t now)
+{
+    timer->target = (uint32_t)target;
+    timer->long_target = target >> 32;
+    _wheel_add(timer);
+    _rearm(now);
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+    if (!long_offset) {
+        /* timer fits into the short timer */
+        xtimer_set(timer, (uint32_t) offset);
+    }
+    else {
+        int state = irq_disable();
+        if (_is_set(timer)) {
+            _unlink(timer);
+        }
+
+        uint64_t now = _now64();
+        _add(timer, now + (((uint64_t)long_offset << 32) | offset), now);
+        irq_restore(state);
+        DEBUG("xtimer_set64(): added longterm timer (long_target=%" PRIu32 " target=%" PRIu32 ")\n",
+                timer->long_target, timer->target);
+    }
+}
+
+void xtimer_set(xtimer_t *timer, uint32_t offset)
+{
+    DEBUG("timer_set(): offset=%" PRIu32 " now=%" PRIu32 " (%" PRIu32 ")\n", offset, xtimer_now(), _xtimer_lltimer_now());
+    if (!timer->callback) {
+        DEBUG("timer_set(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (offset < XTIMER_BACKOFF) {
+        xtimer_spin(offset);
+        _shoot(timer);
+    }
+    else {
+        uint32_t target = xtimer_now() + offset;
+        _xtimer_set_absolute(timer, target);
+    }
+}
+
+int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
+{
+    uint32_t now = xtimer_now();
+
+    DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
+
+    timer->next = NULL;
+    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+        /* backoff */
+        xtimer_spin_until(target + XTIMER_BACKOFF);
+        _shoot(timer);
+        return 0;
+    }
+
+    /* xtimer_set() and xtimer_set_slack() remove the timer beforehand,
+     * xtimer_periodic_wakeup() passes an uninitialized one */
+    unsigned state = irq_disable();
+
+    /* targets before now are in the next 32bit period */
+    uint64_t now64 = _now64();
+    _add(timer, now64 + (uint32_t)(target - (uint32_t)now64), now64);
+
+    irq_restore(state);
+
+    return 0;
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    int state = irq_disable();
+    if (_is_set(timer)) {
+        _unlink(timer);
+        timer->target = 0;
+        timer->long_target = 0;
+    }
+    irq_restore(state);
+}
+
+/**
+ * @brief main xtimer callback function
+ */
+static void _timer_callback(void)
+{
+    uint64_t now, next;
+    unsigned level;
+#ifdef MODULE_XTIMER_STATS
+    uint32_t fired = xtimer_stats.fired;
+#endif
+
+    _in_handler = 1;
+
+    while (1) {
+        now = _now64();
+        _wheel_advance(now);
+
+        next = _wheel_next(&level);
+        if (next > _next_checkpoint(now)) {
+            next = _next_checkpoint(now);
+        }
+
+        if ((next - now) >= XTIMER_ISR_BACKOFF) {
+            break;
+        }
+
+        /* next event is too close to set the low-level timer, wait for it */
+        while (_now64() < next) {}
+    }
+
+#ifdef MODULE_XTIMER_STATS
+    if (xtimer_stats.fired != fired) {
+        xtimer_stats.wakeups++;
+    }
+#endif
+
+    _xtimer_coarse_update(now);
+
+    _in_handler = 0;
+
+    /* schedule callback on next timer target time or checkpoint */
+    _armed_time = next;
+    _lltimer_set((uint32_t)next - XTIMER_OVERHEAD);
+}
+
+#endif /* MODULE_XTIMER_WHEEL */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test and benchmark for channels
+ *
+ * Passes payloads of 64 to 1024 bytes from the main thread to a consumer
+ * thread, once with msg_send_receive() handing over a pointer to the
+ * sender's buffer and once through a channel, and prints the throughput of
+ * both.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "channel.h"
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef PAYLOAD_NUMOF
+#define PAYLOAD_NUMOF       (10000U)
+#endif
+
+#define PAYLOAD_MAX         (1024U)
+#define SLOT_NUMOF          (8U)
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+} payload_t;
+
+static char msg_stack[THREAD_STACKSIZE_MAIN];
+static char chan_stack[THREAD_STACKSIZE_MAIN];
+
+static size_t buf_aligned[CHANNEL_BUF_SIZE(SLOT_NUMOF, PAYLOAD_MAX) /
+                          sizeof(size_t)];
+static channel_t chan;
+
+static uint8_t send_buf[PAYLOAD_MAX];
+static uint8_t recv_buf[PAYLOAD_MAX];
+
+static volatile unsigned received;
+static volatile unsigned errors;
+
+static void _check(const uint8_t *data, size_t len, uint8_t seq)
+{
+    if ((len == 0) || (data[0] != seq) || (data[len - 1] != seq)) {
+        errors++;
+    }
+    received++;
+}
+
+static void *_msg_consumer(void *arg)
+{
+    uint8_t seq = 0;
+
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+        msg_receive(&msg);
+        payload_t *payload = msg.content.ptr;
+        size_t len = payload->len;
+        /* the sender reuses its buffer as soon as we reply */
+        memcpy(recv_buf, payload->data, len);
+        msg_reply(&msg, &msg);
+        _check(recv_buf, len, seq++);
+    }
+
+    return NULL;
+}
+
+static void *_channel_consumer(void *arg)
+{
+    uint8_t seq = 0;
+
+    (void)arg;
+
+    while (1) {
+        size_t len;
+        uint8_t *data = channel_peek(&chan, &len);
+        _check(data, len, seq++);
+        channel_consume(&chan);
+    }
+
+    return NULL;
+}
+
+static void _print(const char *name, size_t len, uint32_t duration)
+{
+    if (duration == 0) {
+        duration = 1;
+    }
+    printf("%s %4u B: %" PRIu32 " us (%" PRIu32 " kB/s)\n", name,
+           (unsigned)len, duration,
+           (uint32_t)(((uint64_t)PAYLOAD_NUMOF * len * 1000U) / duration));
+}
+
+static void _bench_msg(kernel_pid_t pid, size_t len)
+{
+    payload_t payload = { .data = send_buf, .len = len };
+    uint8_t seq = 0;
+
+    received = 0;
+    uint32_t start = xtimer_now();
+
+    for (unsigned i = 0; i < PAYLOAD_NUMOF; i++) {
+        msg_t msg;
+        memset(send_buf, seq++, len);
+        msg.content.ptr = &payload;
+        msg_send_receive(&msg, &msg, pid);
+    }
+
+    _print("msg_send_receive", len, xtimer_now() - start);
+}
+
+static void _bench_channel(size_t len)
+{
+    uint8_t seq = 0;
+
+    received = 0;
+    uint32_t start = xtimer_now();
+
+    for (unsigned i = 0; i < PAYLOAD_NUMOF; i++) {
+        uint8_t *data = channel_reserve(&chan);
+        memset(data, seq++, len);
+        channel_commit(&chan, len);
+    }
+    /* wait for the consumer to drain the channel */
+    while (received < PAYLOAD_NUMOF) {
+        thread_yield();
+    }
+
+    _print("channel         ", len, xtimer_now() - start);
+}
+
+int main(void)
+{
+    puts("channel test");
+
+    channel_init(&chan, buf_aligned, SLOT_NUMOF, PAYLOAD_MAX);
+
+    /* producer and consumers run at the same priority, so the producer
+     * fills the channel before the consumer drains it in one go */
+    kernel_pid_t pid = thread_create(msg_stack, sizeof(msg_stack),
+                                     THREAD_PRIORITY_MAIN, 0,
+                                     _msg_consumer, NULL, "msg consumer");
+    thread_create(chan_stack, sizeof(chan_stack), THREAD_PRIORITY_MAIN, 0,
+                  _channel_consumer, NULL, "channel consumer");
+
+    for (size_t len = 64; len <= PAYLOAD_MAX; len *= 2) {
+        _bench_msg(pid, len);
+        _bench_channel(len);
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u corrupted payloads\n", errors);
+    }
+
+    return 0;
+}
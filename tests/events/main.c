@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       event test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event.h"
+#include "event/timeout.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT     (10000U)
+
+static unsigned order;
+
+static event_queue_t queue;
+
+static void _handler(event_t *event);
+static void _timeout_handler(event_t *event);
+static void _isr_handler(event_t *event);
+
+static event_t event1 = { .handler = _handler };
+static event_t event2 = { .handler = _handler };
+static event_t event_canceled = { .handler = _handler };
+static event_t event_timed = { .handler = _timeout_handler };
+static event_t event_isr = { .handler = _isr_handler };
+
+static event_timeout_t event_timeout;
+static xtimer_t isr_timer;
+
+static void _handler(event_t *event)
+{
+    printf("triggered %s (%u)\n", (event == &event1) ? "event1" : "event2",
+           ++order);
+}
+
+static void _timeout_handler(event_t *event)
+{
+    (void)event;
+    printf("triggered timed event (%u)\n", ++order);
+}
+
+static void _isr_handler(event_t *event)
+{
+    (void)event;
+    printf("triggered ISR event (%u)\n", ++order);
+    puts("[SUCCESS]");
+}
+
+static void _isr_cb(void *arg)
+{
+    (void)arg;
+    /* posted twice, must only be handled once */
+    event_post(&queue, &event_isr);
+    event_post(&queue, &event_isr);
+}
+
+int main(void)
+{
+    puts("event test application");
+
+    event_queue_init(&queue);
+
+    /* coalescing: event1 is queued only once */
+    event_post(&queue, &event1);
+    event_post(&queue, &event2);
+    event_post(&queue, &event1);
+
+    /* canceled events are never handled */
+    event_post(&queue, &event_canceled);
+    event_cancel(&queue, &event_canceled);
+
+    event_timeout_init(&event_timeout, &queue, &event_timed);
+    event_timeout_set(&event_timeout, TIMEOUT);
+
+    isr_timer.callback = _isr_cb;
+    xtimer_set(&isr_timer, 2 * TIMEOUT);
+
+    event_loop(&queue);
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup benchmark for the FIB
+ *
+ * Fills a FIB with a default route and 10, 100, ... ROUTES_MAX /48 routes
+ * and looks up an address in every route in turn. Prints the average time
+ * per lookup.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/fib.h"
+#include "xtimer.h"
+
+#define LOOKUPS         (10000U)
+
+static fib_entry_t entries[ROUTES_MAX + 1];
+static fib_table_t table = { .data.entries = entries,
+                             .table_type = FIB_TABLE_TYPE_SH,
+                             .size = ROUTES_MAX + 1,
+                             .mtx_access = MUTEX_INIT,
+                             .notify_rp_pos = 0 };
+
+static void _addr(uint8_t *addr, unsigned route, unsigned host)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[4] = (uint8_t)(route >> 8);
+    addr[5] = (uint8_t)route;
+    addr[14] = (uint8_t)(host >> 8);
+    addr[15] = (uint8_t)host;
+}
+
+static int _add_prefix(uint8_t *dst, size_t prefix_len, uint8_t *next_hop)
+{
+    return fib_add_entry(&table, 42, dst, 16,
+                         (prefix_len << FIB_FLAG_NET_PREFIX_SHIFT),
+                         next_hop, 16, 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+/* returns the first byte of the next hop for dst, -1 if there is none */
+static int _next_hop_id(uint8_t *dst)
+{
+    kernel_pid_t iface_id;
+    uint32_t next_hop_flags;
+    uint8_t next_hop[16];
+    size_t next_hop_size = sizeof(next_hop);
+
+    if (fib_get_next_hop(&table, &iface_id, next_hop, &next_hop_size,
+                         &next_hop_flags, dst, 16, 0) != 0) {
+        return -1;
+    }
+    return next_hop[0];
+}
+
+int main(void)
+{
+    uint8_t dst[16], nh[16] = { 0 };
+    unsigned errors = 0;
+
+    printf("fib lookup benchmark, %u lookups per size\n", LOOKUPS);
+    puts(" routes | lookup [ns]");
+    for (unsigned n = 10; n <= ROUTES_MAX; n *= 10) {
+        unsigned found = 0;
+        uint32_t start;
+
+        fib_init(&table);
+        nh[0] = 0xff;
+        memset(dst, 0, sizeof(dst));
+        errors += (_add_prefix(dst, 0, nh) != 0);
+        for (unsigned i = 0; i < n; i++) {
+            _addr(dst, i, 0);
+            nh[0] = i % 10;
+            errors += (_add_prefix(dst, 48, nh) != 0);
+        }
+        start = xtimer_now();
+        for (unsigned i = 0; i < LOOKUPS; i++) {
+            _addr(dst, i % n, i);
+            found += (_next_hop_id(dst) == (int)((i % n) % 10));
+        }
+        printf("%7u | %11" PRIu32 "\n", n,
+               (uint32_t)(((uint64_t)(xtimer_now() - start) * 1000) / LOOKUPS));
+        errors += (found != LOOKUPS);
+        fib_deinit(&table);
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u errors\n", errors);
+    }
+
+    return 0;
+}
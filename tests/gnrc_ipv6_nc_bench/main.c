@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup benchmark for the IPv6 neighbor cache
+ *
+ * Fills the neighbor cache with n neighbors for n = NC_MIN up to
+ * GNRC_IPV6_NC_SIZE and looks every neighbor up in turn, as done for every
+ * outgoing packet. For comparison, the same neighbors are also looked up by
+ * scanning the cache, as the neighbor cache did before it was hashed.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define NC_MIN          (16U)
+#define LOOKUPS         (8192U)
+
+static const uint8_t l2_addr[] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x01 };
+
+static void _addr(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u32[2].u32 = 0;
+    addr->u16[6] = byteorder_htons(i >> 16);
+    addr->u16[7] = byteorder_htons(i & 0xffff);
+}
+
+static gnrc_ipv6_nc_t *_scan_find(const ipv6_addr_t *addr)
+{
+    for (gnrc_ipv6_nc_t *entry = gnrc_ipv6_nc_get_next(NULL); entry != NULL;
+         entry = gnrc_ipv6_nc_get_next(entry)) {
+        if (ipv6_addr_equal(&entry->ipv6_addr, addr)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t iface = thread_getpid();
+    ipv6_addr_t addr;
+    unsigned errors = 0;
+
+    gnrc_ipv6_netif_add(iface);
+
+    printf("neighbor cache benchmark, %u lookups per size\n", LOOKUPS);
+    puts("    n | get [ns] | scan [ns]");
+    for (unsigned n = NC_MIN; n <= GNRC_IPV6_NC_SIZE; n *= 2) {
+        uint32_t start, hashed, scan;
+        unsigned found = 0;
+
+        gnrc_ipv6_nc_init();
+        for (unsigned i = 0; i < n; i++) {
+            _addr(&addr, i);
+            errors += (gnrc_ipv6_nc_add(iface, &addr, l2_addr, sizeof(l2_addr),
+                                        GNRC_IPV6_NC_STATE_STALE) == NULL);
+        }
+
+        start = xtimer_now();
+        for (unsigned i = 0; i < LOOKUPS; i++) {
+            _addr(&addr, (i * 7) % n);
+            found += (gnrc_ipv6_nc_get(iface, &addr) != NULL);
+        }
+        hashed = xtimer_now() - start;
+
+        start = xtimer_now();
+        for (unsigned i = 0; i < LOOKUPS; i++) {
+            _addr(&addr, (i * 7) % n);
+            found += (_scan_find(&addr) != NULL);
+        }
+        scan = xtimer_now() - start;
+
+        printf("%5u | %8" PRIu32 " | %9" PRIu32 "\n", n,
+               (uint32_t)(((uint64_t)hashed * 1000) / LOOKUPS),
+               (uint32_t)(((uint64_t)scan * 1000) / LOOKUPS));
+        errors += (found != (2 * LOOKUPS));
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u errors\n", errors);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Lookup benchmark for gnrc_netreg
+ *
+ * Registers n UDP ports for n = REG_MIN to REG_MAX and looks up every
+ * registered port in turn, plus one unbound port per round. Prints the
+ * average time per lookup.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define REG_MIN         (1U)
+#define REG_MAX         (256U)
+#define LOOKUPS         (4096U)
+#define PORT_BASE       (0xf0b0U)
+#define MSG_QUEUE_SIZE  (4U)
+
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t entries[REG_MAX];
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    /* only threads with a message queue may register */
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+    printf("netreg lookup benchmark, %u lookups per size, %u buckets\n",
+           LOOKUPS, GNRC_NETREG_BUCKETS);
+    puts("    n | lookup [ns]");
+    for (unsigned n = REG_MIN; n <= REG_MAX; n *= 2) {
+        unsigned found = 0, lookups = 0;
+        uint32_t start;
+
+        gnrc_netreg_init();
+        for (unsigned i = 0; i < n; i++) {
+            gnrc_netreg_entry_init_pid(&entries[i], PORT_BASE + i,
+                                       thread_getpid());
+            gnrc_netreg_register(GNRC_NETTYPE_UDP, &entries[i]);
+        }
+        start = xtimer_now();
+        while (lookups < LOOKUPS) {
+            for (unsigned i = 0; i <= n; i++) {
+                found += (gnrc_netreg_lookup(GNRC_NETTYPE_UDP,
+                                             PORT_BASE + i) != NULL);
+            }
+            lookups += n + 1;
+        }
+        printf("%5u | %11" PRIu32 "\n", n,
+               (uint32_t)(((uint64_t)(xtimer_now() - start) * 1000) / lookups));
+        if (found != ((lookups / (n + 1)) * n)) {
+            errors++;
+        }
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] wrong lookup results for %u sizes\n", errors);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    Test application for the heap-backed packet buffer
+ *
+ * Allocates a burst of packets larger than @ref GNRC_PKTBUF_SIZE, checks
+ * the soft cap and the per-nettype accounting, and that all memory is
+ * returned once the packets are released.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/pktbuf.h"
+
+#define PAYLOAD_SIZE    (256U)
+#define HDR_SIZE        (24U)
+#define MAX_PKTS        (GNRC_PKTBUF_MALLOC_LIMIT / PAYLOAD_SIZE)
+
+static gnrc_pktsnip_t *pkts[MAX_PKTS];
+
+static unsigned _fill(void)
+{
+    unsigned count = 0;
+
+    while (count < MAX_PKTS) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            break;
+        }
+        pkts[count] = gnrc_pktbuf_add(pkt, NULL, HDR_SIZE, GNRC_NETTYPE_NETIF);
+        if (pkts[count] == NULL) {
+            gnrc_pktbuf_release(pkt);
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+static void _release(unsigned count)
+{
+    for (unsigned i = 0; i < count; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+}
+
+int main(void)
+{
+    gnrc_pktbuf_alloc_stats_t stats;
+    unsigned count, bytes;
+    int res = 0;
+
+    puts("gnrc_pktbuf_malloc test");
+
+    /* burst larger than the static packet buffer */
+    count = _fill();
+    bytes = count * (PAYLOAD_SIZE + HDR_SIZE);
+    printf("burst: %u packets, %u bytes (GNRC_PKTBUF_SIZE: %u)\n", count, bytes,
+           GNRC_PKTBUF_SIZE);
+    if (bytes <= GNRC_PKTBUF_SIZE) {
+        puts("error: burst did not exceed GNRC_PKTBUF_SIZE");
+        res = -1;
+    }
+    if ((gnrc_pktbuf_malloc_usage(GNRC_NETTYPE_UNDEF) != count * PAYLOAD_SIZE) ||
+        (gnrc_pktbuf_malloc_usage(GNRC_NETTYPE_NETIF) != count * HDR_SIZE)) {
+        puts("error: wrong per-nettype usage");
+        res = -1;
+    }
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    if ((stats.alloc_fail == 0) || (stats.free_bytes >= PAYLOAD_SIZE + HDR_SIZE)) {
+        puts("error: soft cap not reached");
+        res = -1;
+    }
+    gnrc_pktbuf_stats();
+    _release(count);
+
+    /* lower soft cap */
+    gnrc_pktbuf_malloc_set_limit(GNRC_PKTBUF_SIZE / 2);
+    count = _fill();
+    bytes = count * (PAYLOAD_SIZE + HDR_SIZE);
+    printf("limit %u: %u packets, %u bytes\n", GNRC_PKTBUF_SIZE / 2, count,
+           bytes);
+    if ((count == 0) || (bytes > GNRC_PKTBUF_SIZE / 2)) {
+        puts("error: soft cap not applied");
+        res = -1;
+    }
+    _release(count);
+    gnrc_pktbuf_malloc_set_limit(GNRC_PKTBUF_MALLOC_LIMIT);
+
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    if ((stats.free_bytes != GNRC_PKTBUF_MALLOC_LIMIT) || (stats.snips_used != 0) ||
+        (gnrc_pktbuf_malloc_usage(GNRC_NETTYPE_UNDEF) != 0) ||
+        (gnrc_pktbuf_malloc_usage(GNRC_NETTYPE_NETIF) != 0)) {
+        puts("error: packet buffer not empty after releasing all packets");
+        res = -1;
+    }
+
+    puts(res ? "[FAILURE]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    Packet buffer allocation stress test
+ *
+ * Builds packets of a netif header, two protocol headers and a payload of
+ * random size, keeping a window of them alive while replacing the oldest
+ * one. Prints the time per gnrc_pktbuf_add() call, then fills the packet
+ * buffer to find the maximum number of packets it holds after the churn.
+ *
+ * Build with `PKTBUF_SLAB=0` to compare against the first-fit allocator for
+ * snip descriptors, or with `PKTBUF=malloc` for the heap-backed packet
+ * buffer.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef ROUNDS
+#define ROUNDS          (10000U)
+#endif
+
+#ifndef WINDOW
+#define WINDOW          (8U)
+#endif
+
+#define PAYLOAD_MIN     (16U)
+#define PAYLOAD_MAX     (256U)
+#define NETIF_HDR_SIZE  (sizeof(gnrc_netif_hdr_t) + 4)
+#define SNIPS_PER_PKT   (4U)
+
+#ifdef MODULE_GNRC_PKTBUF_MALLOC
+#define MAX_PKTS        (GNRC_PKTBUF_MALLOC_LIMIT / PAYLOAD_MIN)
+#else
+#define MAX_PKTS        (GNRC_PKTBUF_SIZE / PAYLOAD_MIN)
+#endif
+
+static gnrc_pktsnip_t *pkts[MAX_PKTS];
+static uint32_t seed = 1;
+
+static unsigned _rand_payload(void)
+{
+    seed = (seed * 1103515245) + 12345;
+    return PAYLOAD_MIN + ((seed >> 8) % (PAYLOAD_MAX - PAYLOAD_MIN));
+}
+
+static gnrc_pktsnip_t *_build(unsigned payload)
+{
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, payload, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    /* transport and network layer header */
+    hdr = gnrc_pktbuf_add(pkt, NULL, 8, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = hdr;
+    hdr = gnrc_pktbuf_add(pkt, NULL, 40, GNRC_NETTYPE_UNDEF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = hdr;
+    hdr = gnrc_pktbuf_add(pkt, NULL, NETIF_HDR_SIZE, GNRC_NETTYPE_NETIF);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return hdr;
+}
+
+static void _print_stats(void)
+{
+    gnrc_pktbuf_alloc_stats_t stats;
+
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    printf("arena allocs: %" PRIu32 " (%" PRIu32 " failed), "
+           "walk avg/max: %" PRIu32 "/%" PRIu32 "\n",
+           stats.alloc_num, stats.alloc_fail,
+           stats.alloc_num ? (stats.alloc_walk / stats.alloc_num) : 0,
+           stats.alloc_walk_max);
+    printf("free: %u bytes in %u chunks, largest %u, fragmentation %u%%\n",
+           (unsigned)stats.free_bytes, (unsigned)stats.free_chunks,
+           (unsigned)stats.largest_free,
+           stats.free_bytes ?
+           (unsigned)(100 - ((stats.largest_free * 100) / stats.free_bytes)) : 0);
+    printf("snips: %u used, %u max\n", stats.snips_used, stats.snips_max);
+}
+
+int main(void)
+{
+    gnrc_pktbuf_alloc_stats_t stats;
+    unsigned count = 0, bytes = 0;
+    size_t free_bytes;
+    uint32_t start, elapsed;
+    int res = 0;
+
+    puts("gnrc_pktbuf stress test");
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    free_bytes = stats.free_bytes;
+
+    for (unsigned i = 0; i < WINDOW; i++) {
+        pkts[i] = _build(_rand_payload());
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        unsigned slot = i % WINDOW;
+
+        gnrc_pktbuf_release(pkts[slot]);
+        pkts[slot] = _build(_rand_payload());
+        if (pkts[slot] == NULL) {
+            printf("error: allocation failed in round %u\n", i);
+            res = -1;
+            break;
+        }
+    }
+    elapsed = xtimer_now() - start;
+    printf("churn: %u packets, %" PRIu32 " ns per gnrc_pktbuf_add()\n", ROUNDS,
+           (uint32_t)(((uint64_t)elapsed * 1000) / (ROUNDS * SNIPS_PER_PKT)));
+    _print_stats();
+
+    /* fill up the packet buffer on top of the remaining window */
+    count = WINDOW;
+    while (count < MAX_PKTS) {
+        unsigned payload = _rand_payload();
+
+        pkts[count] = _build(payload);
+        if (pkts[count] == NULL) {
+            break;
+        }
+        bytes += payload;
+        count++;
+    }
+    printf("max load: %u packets, %u payload bytes\n", count, bytes);
+    _print_stats();
+
+    for (unsigned i = 0; i < count; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    gnrc_pktbuf_cache_flush();
+#endif
+
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    if ((stats.free_bytes != free_bytes) || (stats.snips_used != 0)) {
+        puts("error: packet buffer not empty after releasing all packets");
+        res = -1;
+    }
+
+    puts(res ? "[FAILURE]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    Multi-threaded packet buffer benchmark
+ *
+ * Several producer threads build packets of a netif header and a payload and
+ * hand every packet to all consumer threads, like gnrc_netapi does for
+ * multiple subscribers. The consumers release their reference right away.
+ * Prints the number of packets passed per second and checks that the packet
+ * buffer is empty afterwards.
+ *
+ * Build with `PKTBUF_CACHE=0` to compare against the packet buffer without
+ * per-thread caches.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef PACKETS
+#define PACKETS         (5000U)
+#endif
+
+#define PRODUCERS_NUMOF (2U)
+#define CONSUMERS_NUMOF (2U)
+#define PAYLOAD_SIZE    (64U)
+#define NETIF_HDR_SIZE  (sizeof(gnrc_netif_hdr_t) + 4)
+#define QUEUE_SIZE      (8U)
+
+#define MSG_TYPE_PKT    (0x4001)
+#define MSG_TYPE_DONE   (0x4002)
+
+static char _producer_stacks[PRODUCERS_NUMOF][THREAD_STACKSIZE_MAIN];
+static char _consumer_stacks[CONSUMERS_NUMOF][THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _consumers[CONSUMERS_NUMOF];
+static kernel_pid_t _main_pid;
+static unsigned _failed;
+
+static void _done(void)
+{
+    msg_t msg = { .type = MSG_TYPE_DONE };
+
+#ifdef MODULE_GNRC_PKTBUF_CACHE
+    gnrc_pktbuf_cache_flush();
+#endif
+    msg_send(&msg, _main_pid);
+}
+
+static void *_producer(void *arg)
+{
+    (void)arg;
+
+    for (unsigned i = 0; i < PACKETS; i++) {
+        gnrc_pktsnip_t *pkt, *hdr;
+        msg_t msg = { .type = MSG_TYPE_PKT };
+
+        pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_SIZE, GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            _failed++;
+            continue;
+        }
+        hdr = gnrc_pktbuf_add(pkt, NULL, NETIF_HDR_SIZE, GNRC_NETTYPE_NETIF);
+        if (hdr == NULL) {
+            gnrc_pktbuf_release(pkt);
+            _failed++;
+            continue;
+        }
+        /* our reference is handed over to the first consumer */
+        gnrc_pktbuf_hold(hdr, CONSUMERS_NUMOF - 1);
+        msg.content.ptr = hdr;
+        for (unsigned j = 0; j < CONSUMERS_NUMOF; j++) {
+            msg_send(&msg, _consumers[j]);
+        }
+    }
+    for (unsigned j = 0; j < CONSUMERS_NUMOF; j++) {
+        msg_t msg = { .type = MSG_TYPE_DONE };
+
+        msg_send(&msg, _consumers[j]);
+    }
+    _done();
+    return NULL;
+}
+
+static void *_consumer(void *arg)
+{
+    msg_t queue[QUEUE_SIZE];
+    unsigned producers = PRODUCERS_NUMOF;
+
+    (void)arg;
+    msg_init_queue(queue, QUEUE_SIZE);
+    while (producers > 0) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_PKT) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+        else if (msg.type == MSG_TYPE_DONE) {
+            producers--;
+        }
+    }
+    _done();
+    return NULL;
+}
+
+int main(void)
+{
+    gnrc_pktbuf_alloc_stats_t stats;
+    size_t free_bytes;
+    uint32_t start, elapsed;
+    unsigned packets = PRODUCERS_NUMOF * PACKETS;
+
+    puts("gnrc_pktbuf multi-threaded benchmark");
+    _main_pid = thread_getpid();
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    free_bytes = stats.free_bytes;
+
+    for (unsigned i = 0; i < CONSUMERS_NUMOF; i++) {
+        _consumers[i] = thread_create(_consumer_stacks[i],
+                                      sizeof(_consumer_stacks[i]),
+                                      THREAD_PRIORITY_MAIN - 2,
+                                      THREAD_CREATE_WOUT_YIELD |
+                                      THREAD_CREATE_STACKTEST,
+                                      _consumer, NULL, "consumer");
+    }
+    for (unsigned i = 0; i < PRODUCERS_NUMOF; i++) {
+        thread_create(_producer_stacks[i], sizeof(_producer_stacks[i]),
+                      THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      _producer, NULL, "producer");
+    }
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < (PRODUCERS_NUMOF + CONSUMERS_NUMOF); i++) {
+        msg_t msg;
+
+        msg_receive(&msg);
+    }
+    elapsed = xtimer_now() - start;
+
+    packets -= _failed;
+    printf("%u packets in %" PRIu32 " us, %" PRIu32 " packets/s\n", packets,
+           elapsed,
+           elapsed ? (uint32_t)(((uint64_t)packets * SEC_IN_USEC) / elapsed) : 0);
+
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    if ((stats.free_bytes != free_bytes) || (stats.snips_used != 0)) {
+        puts("error: packet buffer not empty after releasing all packets");
+        puts("[FAILURE]");
+        return 1;
+    }
+    if (_failed > 0) {
+        printf("error: %u allocations failed\n", _failed);
+        puts("[FAILURE]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
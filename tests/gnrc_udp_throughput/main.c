@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    UDP send rate benchmark for GNRC over the native tap interface
+ *
+ * Sends UDP packets of several payload sizes to the all-nodes multicast
+ * address and prints the number of packets sent per second for every size.
+ * The main thread has a lower priority than the network stack, so every
+ * packet is handed to the tap interface before the next one is built.
+ *
+ * Build with `CSUM_OFFLOAD=0` to compare against the stack computing the
+ * UDP checksums.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/udp.h"
+#include "xtimer.h"
+
+#ifndef PACKETS
+#define PACKETS         (10000U)
+#endif
+
+#define PORT            (9U)    /* discard */
+#define PAYLOAD_MAX     (1232U) /* IPv6 minimum MTU minus IPv6 and UDP header */
+
+static const uint16_t _sizes[] = { 64U, 512U, PAYLOAD_MAX };
+static uint8_t _payload[PAYLOAD_MAX];
+
+static unsigned _send(const ipv6_addr_t *dst, uint16_t size)
+{
+    unsigned failed = 0;
+
+    for (unsigned i = 0; i < PACKETS; i++) {
+        gnrc_pktsnip_t *payload, *udp, *ip;
+
+        payload = gnrc_pktbuf_add(NULL, _payload, size, GNRC_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            failed++;
+            continue;
+        }
+        udp = gnrc_udp_hdr_build(payload, PORT, PORT);
+        if (udp == NULL) {
+            gnrc_pktbuf_release(payload);
+            failed++;
+            continue;
+        }
+        ip = gnrc_ipv6_hdr_build(udp, NULL, dst);
+        if (ip == NULL) {
+            gnrc_pktbuf_release(udp);
+            failed++;
+            continue;
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL, ip)) {
+            gnrc_pktbuf_release(ip);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+int main(void)
+{
+    ipv6_addr_t dst = IPV6_ADDR_ALL_NODES_LINK_LOCAL;
+    unsigned failed = 0;
+
+    puts("gnrc_udp send rate benchmark");
+    memset(_payload, 0xa5, sizeof(_payload));
+
+    for (unsigned i = 0; i < (sizeof(_sizes) / sizeof(_sizes[0])); i++) {
+        uint32_t start, elapsed;
+        unsigned packets;
+
+        start = xtimer_now();
+        packets = PACKETS - _send(&dst, _sizes[i]);
+        elapsed = xtimer_now() - start;
+
+        printf("%u packets of %u byte in %" PRIu32 " us, %" PRIu32 " packets/s\n",
+               packets, (unsigned)_sizes[i], elapsed,
+               elapsed ? (uint32_t)(((uint64_t)packets * SEC_IN_USEC) / elapsed) : 0);
+        failed += PACKETS - packets;
+    }
+
+    if (failed > 0) {
+        printf("error: %u packets could not be sent\n", failed);
+        puts("[FAILURE]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
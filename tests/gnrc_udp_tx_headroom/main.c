@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    UDP transmit path benchmark for packet buffer headroom
+ *
+ * Sends UDP packets to the link-local all-nodes address over the default
+ * network interface (netdev2_tap on native) and prints the packet buffer
+ * allocations per packet and the transmit throughput.
+ *
+ * Build with `PKTBUF_HEADROOM=0` to compare against allocating every
+ * header separately.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef PACKETS
+#define PACKETS         (10000U)
+#endif
+
+#ifndef PAYLOAD_SIZE
+#define PAYLOAD_SIZE    (64U)
+#endif
+
+#define PORT            (0x2ea5)
+
+static uint8_t payload[PAYLOAD_SIZE];
+
+static bool _pktbuf_drained(void)
+{
+    gnrc_pktbuf_alloc_stats_t stats;
+
+    gnrc_pktbuf_get_alloc_stats(&stats);
+    return (stats.free_bytes == GNRC_PKTBUF_SIZE) && (stats.snips_used == 0);
+}
+
+int main(void)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = PORT,
+                             .netif = SOCK_ADDR_ANY_NETIF };
+    gnrc_pktbuf_alloc_stats_t before, after;
+    unsigned retries = 0;
+    uint32_t start, elapsed;
+    int res = 0;
+
+    puts("gnrc UDP TX headroom benchmark");
+    printf("headroom: %u bytes, payload: %u bytes\n",
+           (unsigned)GNRC_PKTBUF_HEADROOM, PAYLOAD_SIZE);
+    memcpy(remote.addr.ipv6, &ipv6_addr_all_nodes_link_local,
+           sizeof(remote.addr.ipv6));
+
+    /* let address auto-configuration settle */
+    xtimer_usleep(100U * 1000U);
+    while (!_pktbuf_drained()) {
+        xtimer_usleep(1000U);
+    }
+
+    gnrc_pktbuf_get_alloc_stats(&before);
+    start = xtimer_now();
+    for (unsigned i = 0; i < PACKETS; i++) {
+        int r;
+
+        payload[0] = (uint8_t)i;
+        while ((r = sock_udp_send(NULL, payload, sizeof(payload),
+                                  &remote)) == -ENOMEM) {
+            /* packet buffer full, let the stack drain it */
+            retries++;
+            thread_yield();
+        }
+        if (r < 0) {
+            printf("error: sock_udp_send() returned %d\n", r);
+            res = -1;
+            break;
+        }
+    }
+    while (!_pktbuf_drained()) {
+        thread_yield();
+    }
+    elapsed = xtimer_now() - start;
+    gnrc_pktbuf_get_alloc_stats(&after);
+
+    printf("sent: %u packets in %" PRIu32 " us (%u retries)\n", PACKETS,
+           elapsed, retries);
+    printf("throughput: %" PRIu32 " packets/s\n",
+           (uint32_t)(((uint64_t)PACKETS * SEC_IN_USEC) / (elapsed ? elapsed : 1)));
+    printf("allocations: %" PRIu32 ".%02" PRIu32 " per packet\n",
+           (after.alloc_num - before.alloc_num) / PACKETS,
+           (((after.alloc_num - before.alloc_num) % PACKETS) * 100) / PACKETS);
+
+    puts(res ? "[FAILURE]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for the Internet checksum
+ *
+ * Sums up buffers of typical packet sizes from 20 B to 1500 B with
+ * inet_csum() and, for comparison, byte by byte like inet_csum_slice() did
+ * before it summed up words.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#define BUF_SIZE        (1500U)
+#define RUNS            (1000U)
+
+static const uint16_t lens[] = { 20, 64, 128, 256, 512, 1280, BUF_SIZE };
+static uint8_t buf[BUF_SIZE];
+
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1U); data += 2, i++) {
+        csum += (uint16_t)(*data << 8) + *(data + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*data << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+
+    return csum;
+}
+
+int main(void)
+{
+    uint32_t x = 0x12345678;
+    unsigned errors = 0;
+
+    /* pseudo-random, so carries happen in every position */
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        x = (x * 1103515245) + 12345;
+        buf[i] = (uint8_t)(x >> 16);
+    }
+
+    printf("internet checksum benchmark, %u runs per size\n", RUNS);
+    puts("  len | csum [ns] | bytewise [ns]");
+    for (unsigned i = 0; i < (sizeof(lens) / sizeof(lens[0])); i++) {
+        uint32_t start, words, bytes;
+        uint16_t sum = 0, ref = 0;
+
+        start = xtimer_now();
+        for (unsigned j = 0; j < RUNS; j++) {
+            sum = inet_csum(sum, buf, lens[i]);
+        }
+        words = xtimer_now() - start;
+
+        start = xtimer_now();
+        for (unsigned j = 0; j < RUNS; j++) {
+            ref = _ref_csum(ref, buf, lens[i]);
+        }
+        bytes = xtimer_now() - start;
+
+        printf("%5u | %9" PRIu32 " | %13" PRIu32 "\n", lens[i],
+               (uint32_t)(((uint64_t)words * 1000) / RUNS),
+               (uint32_t)(((uint64_t)bytes * 1000) / RUNS));
+        errors += (sum != ref);
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u wrong checksums\n", errors);
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test and benchmark for msg_receive_bulk() and
+ *              msg_try_send_bulk()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef MSG_NUMOF
+#define MSG_NUMOF           (100000U)
+#endif
+
+#define QUEUE_SIZE          (16U)
+#define BURST_SIZE          (8U)
+
+static char stack[THREAD_STACKSIZE_MAIN];
+static msg_t queue[QUEUE_SIZE];
+
+static volatile unsigned received;
+static volatile unsigned errors;
+static volatile int bulk;
+static uint32_t value;
+
+static void *_consumer(void *arg)
+{
+    msg_t msgs[BURST_SIZE];
+    uint32_t expected = 0;
+
+    (void)arg;
+    msg_init_queue(queue, QUEUE_SIZE);
+
+    while (1) {
+        unsigned num = 1;
+
+        if (bulk) {
+            num = msg_receive_bulk(msgs, BURST_SIZE);
+        }
+        else {
+            msg_receive(&msgs[0]);
+        }
+
+        for (unsigned i = 0; i < num; i++) {
+            if (msgs[i].content.value != expected++) {
+                errors++;
+            }
+        }
+        received += num;
+    }
+
+    return NULL;
+}
+
+static void _run(kernel_pid_t pid, const char *name)
+{
+    msg_t msgs[BURST_SIZE];
+    uint32_t last = value + MSG_NUMOF;
+
+    received = 0;
+    uint32_t start = xtimer_now();
+
+    while (value < last) {
+        if (bulk) {
+            unsigned num = 0;
+            for (; (num < BURST_SIZE) && (value < last); num++) {
+                msgs[num].content.value = value++;
+            }
+            for (unsigned sent = 0; sent < num;) {
+                sent += msg_try_send_bulk(&msgs[sent], num - sent, pid);
+            }
+        }
+        else {
+            msgs[0].content.value = value++;
+            msg_send(&msgs[0], pid);
+        }
+    }
+
+    uint32_t duration = xtimer_now() - start;
+
+    printf("%s: %u messages in %" PRIu32 " us (%" PRIu32 " msg/s)\n", name,
+           received, duration,
+           (uint32_t)(((uint64_t)MSG_NUMOF * 1000000U) / (duration ? duration : 1)));
+}
+
+int main(void)
+{
+    puts("msg bulk receive test");
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1, 0,
+                                     _consumer, NULL, "consumer");
+
+    bulk = 0;
+    _run(pid, "msg_send/msg_receive");
+    bulk = 1;
+    _run(pid, "msg_try_send_bulk/msg_receive_bulk");
+
+    if ((errors == 0) && (received == MSG_NUMOF)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u messages out of order\n", errors);
+    }
+
+    return 0;
+}
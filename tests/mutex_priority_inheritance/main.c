@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application measuring the worst-case wake latency of a
+ *              high priority thread blocked on a mutex held by a lower
+ *              priority thread
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS          (20U)
+#define HOLD_TIME       (1000U)     /**< time each low thread holds its lock */
+#define MID_TIME        (20000U)    /**< time the mid thread keeps the CPU */
+
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 4)
+#define PRIO_MID        (THREAD_PRIORITY_MAIN - 3)
+#define PRIO_LOW        (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_LOWEST     (THREAD_PRIORITY_MAIN - 1)
+
+static char stack_high[THREAD_STACKSIZE_MAIN];
+static char stack_mid[THREAD_STACKSIZE_MAIN];
+static char stack_low[THREAD_STACKSIZE_MAIN];
+static char stack_lowest[THREAD_STACKSIZE_MAIN];
+
+static kernel_pid_t pid_high, pid_mid, pid_low, pid_lowest;
+
+/* high waits on outer, which is held by low, which waits on inner, which is
+ * held by lowest */
+static mutex_t outer = MUTEX_INIT;
+static mutex_t inner = MUTEX_INIT;
+
+static uint32_t worst;
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        /* make the mid thread runnable, it only runs once we block */
+        thread_wakeup(pid_mid);
+
+        uint32_t start = xtimer_now();
+        mutex_lock(&outer);
+        uint32_t latency = xtimer_now() - start;
+        mutex_unlock(&outer);
+
+        printf("high: woke up after %" PRIu32 " us\n", latency);
+        if (latency > worst) {
+            worst = latency;
+        }
+    }
+
+    return NULL;
+}
+
+static void *_mid(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        xtimer_spin(MID_TIME);
+    }
+
+    return NULL;
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        mutex_lock(&outer);
+        thread_wakeup(pid_high);
+        mutex_lock(&inner);
+        xtimer_spin(HOLD_TIME);
+        mutex_unlock(&inner);
+        mutex_unlock(&outer);
+    }
+
+    return NULL;
+}
+
+static void *_lowest(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        mutex_lock(&inner);
+        thread_wakeup(pid_low);
+        xtimer_spin(HOLD_TIME);
+        mutex_unlock(&inner);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Mutex priority inheritance test");
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    puts("priority inheritance: on");
+#else
+    puts("priority inheritance: off");
+#endif
+
+    pid_high = thread_create(stack_high, sizeof(stack_high), PRIO_HIGH,
+                             THREAD_CREATE_SLEEPING, _high, NULL, "high");
+    pid_mid = thread_create(stack_mid, sizeof(stack_mid), PRIO_MID,
+                            THREAD_CREATE_SLEEPING, _mid, NULL, "mid");
+    pid_low = thread_create(stack_low, sizeof(stack_low), PRIO_LOW,
+                            THREAD_CREATE_SLEEPING, _low, NULL, "low");
+    pid_lowest = thread_create(stack_lowest, sizeof(stack_lowest), PRIO_LOWEST,
+                               THREAD_CREATE_SLEEPING, _lowest, NULL, "lowest");
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        /* all other threads have a higher priority, so the round is over
+         * once we get the CPU back */
+        thread_wakeup(pid_lowest);
+    }
+
+    printf("worst-case latency: %" PRIu32 " us\n", worst);
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    if (worst < MID_TIME) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+#endif
+
+    return 0;
+}
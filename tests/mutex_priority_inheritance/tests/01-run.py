@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+ROUNDS = 20
+
+def testfunc(child):
+    child.expect(u"priority inheritance: on")
+    for i in range(ROUNDS):
+        child.expect(u"high: woke up after \d+ us")
+    child.expect(u"worst-case latency: \d+ us")
+    child.expect_exact(u"[SUCCESS]")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
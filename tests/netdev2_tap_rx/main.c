@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive rate benchmark for the native tap interface
+ *
+ * Counts the frames arriving at the tap interface and prints the number of
+ * frames per second.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MSG_QUEUE_SIZE      (32U)
+#define MSG_TYPE_REPORT     (0x4242)
+
+#ifndef REPORT_INTERVAL
+#define REPORT_INTERVAL     (1000000U)
+#endif
+
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                        GNRC_NETREG_DEMUX_CTX_ALL,
+                                        sched_active_pid);
+    xtimer_t timer;
+    msg_t report = { .type = MSG_TYPE_REPORT };
+    uint32_t frames = 0, last = xtimer_now();
+
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+
+    /* without a network layer all frames are handed up as
+     * GNRC_NETTYPE_UNDEF */
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    puts("netdev2_tap receive rate benchmark");
+    xtimer_set_msg(&timer, REPORT_INTERVAL, &report, sched_active_pid);
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                frames++;
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case MSG_TYPE_REPORT: {
+                uint32_t now = xtimer_now();
+                printf("%" PRIu32 " frames/s\n",
+                       (uint32_t)(((uint64_t)frames * 1000000) / (now - last)));
+                frames = 0;
+                last = now;
+                xtimer_set_msg(&timer, REPORT_INTERVAL, &report,
+                               sched_active_pid);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    Test for timer targets far ahead
+ *
+ * Arms the timer the way xtimer does while no timers are set: for the end of
+ * the 32 bit period, re-arming the same target from the callback. No timer
+ * interrupt may fire while idling like this. Targets just behind the counter
+ * are a full period ahead and must not fire either.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "periph/timer.h"
+
+#define TIM_DEV         TIMER_DEV(0)
+#define TIM_SPEED       (1000000ul)
+#define TIM_CHAN        (0)
+
+#define IDLE_TIME       (1000000U)  /**< time spent idling in us */
+#define NEAR_TARGET     (10000U)    /**< offset of the target that must fire */
+
+static volatile unsigned fired;
+static volatile unsigned rearm_target;
+static volatile int rearm;
+
+static void _cb(void *arg, int chan)
+{
+    (void)arg;
+
+    fired++;
+    if (rearm) {
+        timer_set_absolute(TIM_DEV, chan, rearm_target);
+    }
+}
+
+static void _idle(uint32_t time)
+{
+    uint32_t start = timer_read(TIM_DEV);
+
+    while ((timer_read(TIM_DEV) - start) < time) {}
+}
+
+static int _check(const char *what, unsigned value, int rearm_cb,
+                  unsigned expected)
+{
+    fired = 0;
+    rearm = rearm_cb;
+    rearm_target = value;
+    timer_set_absolute(TIM_DEV, TIM_CHAN, value);
+    _idle(IDLE_TIME);
+    rearm = 0;
+    timer_clear(TIM_DEV, TIM_CHAN);
+
+    printf("%s: %u interrupts, expected %u\n", what, fired, expected);
+    return (fired == expected) ? 0 : -1;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("\nTest for timer targets far ahead\n");
+
+    if (timer_init(TIM_DEV, TIM_SPEED, _cb, NULL) < 0) {
+        puts("[FAILED] timer_init");
+        return 1;
+    }
+
+    res |= _check("end of period", 0xffffffff, 1, 0);
+    res |= _check("just passed", timer_read(TIM_DEV) - 1, 1, 0);
+    res |= _check("near", timer_read(TIM_DEV) + NEAR_TARGET, 0, 1);
+
+    puts((res == 0) ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of priority_heap against priority_queue
+ *
+ * Fills queues of n nodes with pseudo random priorities and empties them
+ * again, for both the sorted list and the heap, for n = BENCH_MIN to
+ * BENCH_MAX. Prints the time of both and the smallest n the heap is faster
+ * for.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "priority_heap.h"
+#include "priority_queue.h"
+#include "xtimer.h"
+
+#define BENCH_MIN       (4U)
+#define BENCH_MAX       (512U)
+#define BENCH_OPS       (BENCH_MAX * 32)
+
+static priority_queue_node_t qe[BENCH_MAX];
+static priority_heap_node_t he[BENCH_MAX];
+static unsigned errors;
+
+static uint32_t _prio(uint32_t *state)
+{
+    *state = (*state * 1103515245U) + 12345U;
+    return (*state >> 16) & 0xff;
+}
+
+static uint32_t _bench_queue(unsigned n)
+{
+    priority_queue_t queue = PRIORITY_QUEUE_INIT;
+    uint32_t state = n;
+    uint32_t start = xtimer_now();
+
+    for (unsigned r = 0; r < (BENCH_OPS / n); r++) {
+        priority_queue_node_t *node;
+        uint32_t last = 0;
+
+        for (unsigned i = 0; i < n; i++) {
+            qe[i].priority = _prio(&state);
+            priority_queue_add(&queue, &qe[i]);
+        }
+        while ((node = priority_queue_remove_head(&queue))) {
+            errors += (node->priority < last);
+            last = node->priority;
+        }
+    }
+
+    return xtimer_now() - start;
+}
+
+static uint32_t _bench_heap(unsigned n)
+{
+    priority_heap_t heap = PRIORITY_HEAP_INIT;
+    uint32_t state = n;
+    uint32_t start = xtimer_now();
+
+    for (unsigned r = 0; r < (BENCH_OPS / n); r++) {
+        priority_heap_node_t *node;
+        uint32_t last = 0;
+
+        for (unsigned i = 0; i < n; i++) {
+            he[i].priority = _prio(&state);
+            priority_heap_add(&heap, &he[i]);
+        }
+        while ((node = priority_heap_remove_head(&heap))) {
+            errors += (node->priority < last);
+            last = node->priority;
+        }
+    }
+
+    return xtimer_now() - start;
+}
+
+int main(void)
+{
+    unsigned crossover = 0;
+
+    printf("priority queue benchmark, %u add/remove pairs per size\n",
+           BENCH_OPS);
+    puts("    n | list [us] | heap [us]");
+    for (unsigned n = BENCH_MIN; n <= BENCH_MAX; n *= 2) {
+        uint32_t list_time = _bench_queue(n);
+        uint32_t heap_time = _bench_heap(n);
+
+        printf("%5u | %9" PRIu32 " | %9" PRIu32 "\n", n, list_time, heap_time);
+        if (!crossover && (heap_time < list_time)) {
+            crossover = n;
+        }
+    }
+    if (crossover) {
+        printf("heap faster from n = %u\n", crossover);
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u nodes out of order\n", errors);
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for ringbuffer and tsrb
+ *
+ * Pushes BYTES_NUMOF bytes through a ringbuffer and a tsrb in chunks of
+ * 1 to 256 bytes, once byte by byte, once with the bulk functions and once
+ * with the zero-copy span functions. The buffers start at an odd position, so
+ * chunks regularly wrap around the end of the buffer.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ringbuffer.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef BYTES_NUMOF
+#define BYTES_NUMOF     (1024U * 1024U)
+#endif
+
+#define BUF_SIZE        (512U)
+#define CHUNK_MAX       (256U)
+
+enum {
+    MODE_BYTE,
+    MODE_BULK,
+    MODE_SPAN,
+};
+
+static const char *mode_names[] = { "byte", "bulk", "span" };
+
+static char rb_mem[BUF_SIZE];
+static char tsrb_mem[BUF_SIZE];
+static char src[CHUNK_MAX];
+static char dst[CHUNK_MAX];
+static unsigned errors;
+
+static void _check(unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (dst[i] != src[i]) {
+            errors++;
+            return;
+        }
+    }
+}
+
+/* moves n bytes from src through the ringbuffer to dst */
+static void _rb_chunk(ringbuffer_t *rb, unsigned n, int mode)
+{
+    char *span;
+    unsigned done;
+
+    switch (mode) {
+        case MODE_BYTE:
+            for (unsigned i = 0; i < n; i++) {
+                ringbuffer_add_one(rb, src[i]);
+            }
+            for (unsigned i = 0; i < n; i++) {
+                dst[i] = ringbuffer_get_one(rb);
+            }
+            break;
+        case MODE_BULK:
+            ringbuffer_add(rb, src, n);
+            ringbuffer_get(rb, dst, n);
+            break;
+        case MODE_SPAN:
+            for (done = 0; done < n;) {
+                unsigned len = ringbuffer_peek_span(rb, &span);
+                len = (len > (n - done)) ? (n - done) : len;
+                memcpy(span, &src[done], len);
+                ringbuffer_commit(rb, len);
+                done += len;
+            }
+            for (done = 0; done < n;) {
+                unsigned len = ringbuffer_get_span(rb, &span);
+                len = (len > (n - done)) ? (n - done) : len;
+                memcpy(&dst[done], span, len);
+                ringbuffer_remove(rb, len);
+                done += len;
+            }
+            break;
+    }
+}
+
+static void _tsrb_chunk(tsrb_t *rb, unsigned n, int mode)
+{
+    char *span;
+    unsigned done;
+
+    switch (mode) {
+        case MODE_BYTE:
+            for (unsigned i = 0; i < n; i++) {
+                tsrb_add_one(rb, src[i]);
+            }
+            for (unsigned i = 0; i < n; i++) {
+                dst[i] = tsrb_get_one(rb);
+            }
+            break;
+        case MODE_BULK:
+            tsrb_add(rb, src, n);
+            tsrb_get(rb, dst, n);
+            break;
+        case MODE_SPAN:
+            for (done = 0; done < n;) {
+                size_t len = tsrb_peek_span(rb, &span);
+                len = (len > (n - done)) ? (n - done) : len;
+                memcpy(span, &src[done], len);
+                tsrb_commit(rb, len);
+                done += len;
+            }
+            for (done = 0; done < n;) {
+                size_t len = tsrb_get_span(rb, &span);
+                len = (len > (n - done)) ? (n - done) : len;
+                memcpy(&dst[done], span, len);
+                tsrb_drop(rb, len);
+                done += len;
+            }
+            break;
+    }
+}
+
+static void _print(const char *name, int mode, unsigned chunk, uint32_t duration)
+{
+    if (duration == 0) {
+        duration = 1;
+    }
+    printf("%-10s %s %3u B: %7" PRIu32 " us (%" PRIu32 " kB/s)\n", name,
+           mode_names[mode], chunk, duration,
+           (uint32_t)(((uint64_t)BYTES_NUMOF * 1000U) / duration));
+}
+
+int main(void)
+{
+    ringbuffer_t rb;
+    tsrb_t tsrb;
+
+    puts("ringbuffer throughput test");
+
+    for (unsigned i = 0; i < CHUNK_MAX; i++) {
+        src[i] = (char)i;
+    }
+
+    for (unsigned chunk = 1; chunk <= CHUNK_MAX; chunk *= 4) {
+        for (int mode = MODE_BYTE; mode <= MODE_SPAN; mode++) {
+            /* start at an odd position, so that chunks wrap around */
+            ringbuffer_init(&rb, rb_mem, sizeof(rb_mem));
+            ringbuffer_add(&rb, src, 3);
+            ringbuffer_get(&rb, dst, 3);
+            tsrb_init(&tsrb, tsrb_mem, sizeof(tsrb_mem));
+            tsrb_add(&tsrb, src, 3);
+            tsrb_get(&tsrb, dst, 3);
+
+            memset(dst, 0, sizeof(dst));
+            uint32_t start = xtimer_now();
+            for (unsigned done = 0; done < BYTES_NUMOF; done += chunk) {
+                _rb_chunk(&rb, chunk, mode);
+            }
+            uint32_t rb_time = xtimer_now() - start;
+            _check(chunk);
+
+            memset(dst, 0, sizeof(dst));
+            start = xtimer_now();
+            for (unsigned done = 0; done < BYTES_NUMOF; done += chunk) {
+                _tsrb_chunk(&tsrb, chunk, mode);
+            }
+            uint32_t tsrb_time = xtimer_now() - start;
+            _check(chunk);
+
+            _print("ringbuffer", mode, chunk, rb_time);
+            _print("tsrb", mode, chunk, tsrb_time);
+        }
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u runs with corrupted data\n", errors);
+    }
+
+    return 0;
+}
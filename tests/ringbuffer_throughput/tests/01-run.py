@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+def testfunc(child):
+    for chunk in (1, 4, 16, 64, 256):
+        for mode in ("byte", "bulk", "span"):
+            for name in ("ringbuffer", "tsrb"):
+                child.expect(u"%s +%s +%d B: +\d+ us \(\d+ kB/s\)" %
+                             (name, mode, chunk))
+    child.expect_exact(u"[SUCCESS]")
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc))
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Context switch benchmark
+ *
+ * Measures the cost of a context switch by letting two threads of the same
+ * priority hand over the CPU with thread_yield(), and by ping-ponging
+ * messages with msg_send_receive().
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef SWITCH_NUMOF
+#define SWITCH_NUMOF        (100000UL)
+#endif
+
+static char yield_stack[THREAD_STACKSIZE_MAIN];
+static char reply_stack[THREAD_STACKSIZE_MAIN];
+
+static volatile unsigned long yields;
+
+static void *_yield_thread(void *arg)
+{
+    (void)arg;
+
+    while (yields < SWITCH_NUMOF) {
+        yields++;
+        thread_yield();
+    }
+    return NULL;
+}
+
+static void *_reply_thread(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        msg_reply(&m, &m);
+    }
+    return NULL;
+}
+
+static void _print(const char *name, uint32_t time, unsigned long switches)
+{
+    printf("%-16s %lu switches: %" PRIu32 " us (%" PRIu32 " ns/switch)\n",
+           name, switches, time,
+           (uint32_t)(((uint64_t)time * 1000) / switches));
+}
+
+int main(void)
+{
+    uint32_t start, time;
+    unsigned long switches = 0;
+
+    puts("Context switch benchmark");
+
+    /* both threads run at main's priority, every yield switches to the
+     * other one until it has finished */
+    thread_create(yield_stack, sizeof(yield_stack), THREAD_PRIORITY_MAIN,
+                  THREAD_CREATE_STACKTEST, _yield_thread, NULL, "yield");
+    start = xtimer_now();
+    while (yields < SWITCH_NUMOF) {
+        switches += 2;
+        thread_yield();
+    }
+    time = xtimer_now() - start;
+    _print("thread_yield", time, switches);
+
+    kernel_pid_t pid = thread_create(reply_stack, sizeof(reply_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _reply_thread, NULL, "reply");
+    msg_t m;
+    start = xtimer_now();
+    for (unsigned long i = 0; i < SWITCH_NUMOF; i++) {
+        msg_send_receive(&m, &m, pid);
+    }
+    time = xtimer_now() - start;
+    _print("msg_send_receive", time, 2 * SWITCH_NUMOF);
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-core.h"
+
+#define H_LEN           (64)
+
+static priority_heap_t h = PRIORITY_HEAP_INIT;
+static priority_heap_node_t he[H_LEN];
+
+static void set_up(void)
+{
+    priority_heap_init(&h);
+    for (unsigned i = 0; i < sizeof(he)/sizeof(priority_heap_node_t); ++i) {
+        priority_heap_node_init(&(he[i]));
+    }
+}
+
+static void test_priority_heap_remove_head_empty(void)
+{
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+    TEST_ASSERT_NULL(priority_heap_peek(&h));
+}
+
+static void test_priority_heap_remove_head_one(void)
+{
+    priority_heap_node_t *elem = &(he[1]), *res;
+
+    elem->data = 62801;
+
+    priority_heap_add(&h, elem);
+
+    TEST_ASSERT(priority_heap_peek(&h) == elem);
+
+    res = priority_heap_remove_head(&h);
+
+    TEST_ASSERT(res == elem);
+    TEST_ASSERT_EQUAL_INT(62801, res->data);
+
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_add_two_equal(void)
+{
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]);
+
+    elem1->data = 27088;
+    elem1->priority = 14202;
+
+    elem2->data = 4356;
+    elem2->priority = 14202;
+
+    priority_heap_add(&h, elem1);
+    priority_heap_add(&h, elem2);
+
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem1);
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem2);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_add_two_distinct(void)
+{
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]);
+
+    elem1->data = 46421;
+    elem1->priority = 4567;
+
+    elem2->data = 43088;
+    elem2->priority = 1234;
+
+    priority_heap_add(&h, elem1);
+    priority_heap_add(&h, elem2);
+
+    TEST_ASSERT(priority_heap_peek(&h) == elem2);
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem2);
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem1);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_remove_one(void)
+{
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]), *elem3 = &(he[3]);
+
+    priority_heap_add(&h, elem1);
+    priority_heap_add(&h, elem2);
+    priority_heap_add(&h, elem3);
+    priority_heap_remove(&h, elem2);
+    /* removing twice is harmless */
+    priority_heap_remove(&h, elem2);
+
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem1);
+    TEST_ASSERT(priority_heap_remove_head(&h) == elem3);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_stable_order(void)
+{
+    priority_heap_node_t *res;
+
+    /* few distinct priorities, so many nodes share one */
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = (i * 7) % 5;
+        he[i].data = i;
+        priority_heap_add(&h, &he[i]);
+    }
+    /* remove every third node from the middle of the heap */
+    for (unsigned i = 1; i < H_LEN; i += 3) {
+        priority_heap_remove(&h, &he[i]);
+    }
+
+    res = priority_heap_remove_head(&h);
+    TEST_ASSERT_NOT_NULL(res);
+    for (unsigned n = 1; n < (H_LEN - (H_LEN / 3)); n++) {
+        priority_heap_node_t *next = priority_heap_remove_head(&h);
+
+        TEST_ASSERT_NOT_NULL(next);
+        TEST_ASSERT((next->data % 3) != 1);
+        TEST_ASSERT(res->priority <= next->priority);
+        if (res->priority == next->priority) {
+            TEST_ASSERT(res->data < next->data);
+        }
+        res = next;
+    }
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+Test *tests_core_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_remove_head_empty),
+        new_TestFixture(test_priority_heap_remove_head_one),
+        new_TestFixture(test_priority_heap_add_two_equal),
+        new_TestFixture(test_priority_heap_add_two_distinct),
+        new_TestFixture(test_priority_heap_remove_one),
+        new_TestFixture(test_priority_heap_stable_order),
+    };
+
+    EMB_UNIT_TESTCALLER(core_priority_heap_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&core_priority_heap_tests;
+}
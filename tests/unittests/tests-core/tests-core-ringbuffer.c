@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -114,10 +116,72 @@ static void tests_core_ringbuffer(void)
     run_add();
 }
 
+static void tests_core_ringbuffer_bulk(void)
+{
+    char buf[BUF_SIZE + 2];
+
+    ringbuffer_init(&rb, rb_buf, sizeof(rb_buf));
+
+    /* move start to the middle, so that the next adds wrap */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_add(&rb, "abcd", 4));
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_remove(&rb, 3));
+    assert_avail(1);
+
+    TEST_ASSERT_EQUAL_INT(6, ringbuffer_add(&rb, "efghijkl", 8));
+    assert_avail(BUF_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_add(&rb, "m", 1));
+
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_peek(&rb, buf, 3));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "def", 3));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, ringbuffer_get(&rb, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "defghij", BUF_SIZE));
+    assert_avail(0);
+}
+
+static void tests_core_ringbuffer_span(void)
+{
+    char buf[BUF_SIZE];
+    char *span;
+
+    ringbuffer_init(&rb, rb_buf, sizeof(rb_buf));
+
+    /* an empty buffer is one span */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, ringbuffer_peek_span(&rb, &span));
+    TEST_ASSERT(span == rb_buf);
+    memcpy(span, "abcde", 5);
+    ringbuffer_commit(&rb, 5);
+    assert_avail(5);
+
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_get_span(&rb, &span));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span, "abcde", 5));
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_remove(&rb, 4));
+
+    /* the free space now wraps: first the end, then the start */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_span(&rb, &span));
+    TEST_ASSERT(span == &rb_buf[5]);
+    memcpy(span, "fg", 2);
+    ringbuffer_commit(&rb, 2);
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_peek_span(&rb, &span));
+    TEST_ASSERT(span == rb_buf);
+    memcpy(span, "hijk", 4);
+    ringbuffer_commit(&rb, 4);
+    assert_avail(BUF_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_peek_span(&rb, &span));
+
+    /* so do the used elements */
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_get_span(&rb, &span));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(span, "efg", 3));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, ringbuffer_get(&rb, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "efghijk", BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, ringbuffer_get_span(&rb, &span));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
+        new_TestFixture(tests_core_ringbuffer_bulk),
+        new_TestFixture(tests_core_ringbuffer_span),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
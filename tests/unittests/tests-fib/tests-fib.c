@@ -976,6 +976,196 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief helper to add a route to a prefix of the given length
+*/
+static int _add_prefix(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                       size_t prefix_len, uint8_t *next_hop)
+{
+    return fib_add_entry(table, 42, dst, dst_size,
+                         (prefix_len << FIB_FLAG_NET_PREFIX_SHIFT),
+                         next_hop, dst_size, 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+/*
+* @brief helper to look up the first byte of the next hop for dst
+*/
+static int _next_hop_id(fib_table_t *table, uint8_t *dst, size_t dst_size)
+{
+    kernel_pid_t iface_id;
+    uint32_t next_hop_flags;
+    uint8_t next_hop[UNIVERSAL_ADDRESS_SIZE];
+    size_t next_hop_size = sizeof(next_hop);
+
+    if (fib_get_next_hop(table, &iface_id, next_hop, &next_hop_size,
+                         &next_hop_flags, dst, dst_size, 0) != 0) {
+        return -1;
+    }
+    return next_hop[0];
+}
+
+/*
+* @brief nested prefixes must be matched longest first, also after removing
+* some of them
+*/
+static void test_fib_21_longest_prefix_match(void)
+{
+    uint8_t p0[16] = { 0 };
+    uint8_t p32[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t p48[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t p60[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x10 };
+    uint8_t dst[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x17,
+                        0, 0, 0, 0, 0, 0, 0, 1 };
+    uint8_t nh[16] = { 0 };
+
+    nh[0] = 60;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, p60, 16, 60, nh));
+    nh[0] = 32;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, p32, 16, 32, nh));
+    nh[0] = 1;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, p0, 16, 0, nh));
+    nh[0] = 48;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, p48, 16, 48, nh));
+
+    TEST_ASSERT_EQUAL_INT(60, _next_hop_id(&test_fib_table, dst, 16));
+    /* outside of the /60, but still in the /48 */
+    dst[7] = 0x20;
+    TEST_ASSERT_EQUAL_INT(48, _next_hop_id(&test_fib_table, dst, 16));
+    dst[5] = 0x02;
+    TEST_ASSERT_EQUAL_INT(32, _next_hop_id(&test_fib_table, dst, 16));
+    dst[3] = 0xb9;
+    TEST_ASSERT_EQUAL_INT(1, _next_hop_id(&test_fib_table, dst, 16));
+
+    memcpy(dst, p60, 8);
+    fib_remove_entry(&test_fib_table, p48, 16);
+    TEST_ASSERT_EQUAL_INT(60, _next_hop_id(&test_fib_table, dst, 16));
+    fib_remove_entry(&test_fib_table, p60, 16);
+    TEST_ASSERT_EQUAL_INT(32, _next_hop_id(&test_fib_table, dst, 16));
+    fib_remove_entry(&test_fib_table, p0, 16);
+    dst[3] = 0xb9;
+    TEST_ASSERT_EQUAL_INT(-1, _next_hop_id(&test_fib_table, dst, 16));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief routes for addresses of another size must not match, even if their
+* bytes do
+*/
+static void test_fib_22_address_sizes(void)
+{
+    uint8_t short_dst[8] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t long_dst[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t nh[16] = { 0 };
+
+    nh[0] = 8;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, short_dst, 8, 32, nh));
+    TEST_ASSERT_EQUAL_INT(8, _next_hop_id(&test_fib_table, short_dst, 8));
+    TEST_ASSERT_EQUAL_INT(-1, _next_hop_id(&test_fib_table, long_dst, 16));
+
+    nh[0] = 16;
+    TEST_ASSERT_EQUAL_INT(0, _add_prefix(&test_fib_table, long_dst, 16, 32, nh));
+    TEST_ASSERT_EQUAL_INT(8, _next_hop_id(&test_fib_table, short_dst, 8));
+    TEST_ASSERT_EQUAL_INT(16, _next_hop_id(&test_fib_table, long_dst, 16));
+    TEST_ASSERT_EQUAL_INT(2, fib_get_num_used_entries(&test_fib_table));
+
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief helper to add a host route with the given lifetime in ms
+*/
+static int _add_host(fib_table_t *table, uint8_t *dst, uint32_t lifetime)
+{
+    return fib_add_entry(table, 42, dst, 16, 0, dst, 16, 0, lifetime);
+}
+
+/*
+* @brief expired entries must be removed on the next call after their
+* lifetime passed, the others must be kept
+*/
+static void test_fib_23_lifetime_expiry(void)
+{
+    uint8_t dst[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+
+    dst[15] = 1;
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 20));
+    dst[15] = 2;
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 1000));
+    dst[15] = 3;
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 10));
+    dst[15] = 4;
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst,
+                                       (uint32_t)FIB_LIFETIME_NO_EXPIRE));
+    /* refreshing the lifetime keeps an entry */
+    dst[15] = 3;
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 1000));
+
+    xtimer_usleep(40 * MS_IN_USEC);
+
+    TEST_ASSERT_EQUAL_INT(3, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_expired_entries(&test_fib_table));
+    dst[15] = 1;
+    TEST_ASSERT_EQUAL_INT(-1, _next_hop_id(&test_fib_table, dst, 16));
+    for (uint8_t i = 2; i <= 4; i++) {
+        dst[15] = i;
+        TEST_ASSERT_EQUAL_INT(0x20, _next_hop_id(&test_fib_table, dst, 16));
+    }
+
+    fib_deinit(&test_fib_table);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_expired_entries(&test_fib_table));
+}
+
+/*
+* @brief with an expiry thread, lookups must not remove entries, the thread
+* must be notified instead
+*/
+static void test_fib_24_expiry_thread(void)
+{
+    uint8_t dst[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    msg_t msg;
+
+    fib_set_expiry_thread(&test_fib_table, thread_getpid());
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 10));
+
+    TEST_ASSERT(xtimer_msg_receive_timeout(&msg, 100 * MS_IN_USEC) >= 0);
+    TEST_ASSERT_EQUAL_INT(FIB_MSG_EXPIRE, msg.type);
+    TEST_ASSERT(msg.content.ptr == &test_fib_table);
+    TEST_ASSERT_EQUAL_INT(0x20, _next_hop_id(&test_fib_table, dst, 16));
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_expired_entries(&test_fib_table));
+
+    fib_expire(msg.content.ptr);
+    TEST_ASSERT_EQUAL_INT(-1, _next_hop_id(&test_fib_table, dst, 16));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_expired_entries(&test_fib_table));
+
+    fib_set_expiry_thread(&test_fib_table, KERNEL_PID_UNDEF);
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief if the expiry thread cannot take the notification, it must be told
+* again later
+*/
+static void test_fib_25_expiry_thread_busy(void)
+{
+    uint8_t dst[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    msg_t msg;
+
+    /* the test thread has no message queue, so it misses the first message */
+    fib_set_expiry_thread(&test_fib_table, thread_getpid());
+    TEST_ASSERT_EQUAL_INT(0, _add_host(&test_fib_table, dst, 10));
+    xtimer_usleep(20 * MS_IN_USEC);
+
+    TEST_ASSERT(xtimer_msg_receive_timeout(&msg, 100 * MS_IN_USEC) >= 0);
+    TEST_ASSERT_EQUAL_INT(FIB_MSG_EXPIRE, msg.type);
+    fib_expire(msg.content.ptr);
+    TEST_ASSERT_EQUAL_INT(-1, _next_hop_id(&test_fib_table, dst, 16));
+
+    fib_set_expiry_thread(&test_fib_table, KERNEL_PID_UNDEF);
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1190,11 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_longest_prefix_match),
+                        new_TestFixture(test_fib_22_address_sizes),
+                        new_TestFixture(test_fib_23_lifetime_expiry),
+                        new_TestFixture(test_fib_24_expiry_thread),
+                        new_TestFixture(test_fib_25_expiry_thread_busy),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -21,6 +22,50 @@
 #include "unittests-constants.h"
 #include "tests-inet_csum.h"
 
+#define BUF_SIZE        (1500U)
+
+/* room for every alignment of BUF_SIZE bytes */
+static uint8_t _buf[BUF_SIZE + sizeof(uint64_t)];
+
+static void _fill_buf(void)
+{
+    /* pseudo-random, so carries happen in every position */
+    uint32_t x = TEST_UINT32;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        x = (x * 1103515245) + 12345;
+        _buf[i] = (uint8_t)(x >> 16);
+    }
+}
+
+/* sums up byte by byte, like inet_csum_slice() did before it summed up
+ * words */
+static uint16_t _ref_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+    }
+    for (unsigned i = 0; i < (len >> 1U); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+
+    return csum;
+}
+
 static void test_inet_csum__rfc_example(void)
 {
     /* source: https://tools.ietf.org/html/rfc1071#section-3 */
@@ -165,6 +210,60 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__all_alignments(void)
+{
+    static const uint16_t lens[] = { 1, 2, 3, 7, 8, 15, 16, 17, 31, 33, 63, 64,
+                                     65, 127, 129, 255, 1279, 1280, BUF_SIZE };
+
+    _fill_buf();
+    for (unsigned offset = 0; offset < sizeof(uint64_t); offset++) {
+        for (unsigned i = 0; i < (sizeof(lens) / sizeof(lens[0])); i++) {
+            const uint8_t *buf = &_buf[offset];
+
+            TEST_ASSERT_EQUAL_INT(_ref_csum_slice(0, buf, lens[i], 0),
+                                  inet_csum_slice(0, buf, lens[i], 0));
+            TEST_ASSERT_EQUAL_INT(_ref_csum_slice(TEST_UINT16, buf, lens[i], 1),
+                                  inet_csum_slice(TEST_UINT16, buf, lens[i], 1));
+        }
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    /* the largest sum possible, carries in every word */
+    memset(_buf, 0xff, sizeof(_buf));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0xffff, _buf, BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum_slice(0xffff, &_buf[1], BUF_SIZE, 1));
+}
+
+static void test_inet_csum_update16(void)
+{
+    uint16_t csum, expected;
+
+    _fill_buf();
+    for (unsigned i = 0; i < 64; i += 2) {
+        uint16_t old_word = (_buf[i] << 8) | _buf[i + 1];
+        uint16_t new_word = (uint16_t)(old_word * TEST_UINT16);
+
+        csum = ~inet_csum(0, _buf, 64);
+        _buf[i] = new_word >> 8;
+        _buf[i + 1] = new_word & 0xff;
+        expected = ~inet_csum(0, _buf, 64);
+        TEST_ASSERT_EQUAL_INT(expected, inet_csum_update16(csum, old_word, new_word));
+    }
+}
+
+static void test_inet_csum_update16__no_change(void)
+{
+    TEST_ASSERT_EQUAL_INT(TEST_UINT16, inet_csum_update16(TEST_UINT16, 0x1234, 0x1234));
+}
+
+static void test_inet_csum_update16__rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +275,11 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__all_alignments),
+        new_TestFixture(test_inet_csum__all_ones),
+        new_TestFixture(test_inet_csum_update16),
+        new_TestFixture(test_inet_csum_update16__no_change),
+        new_TestFixture(test_inet_csum_update16__rfc_example),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
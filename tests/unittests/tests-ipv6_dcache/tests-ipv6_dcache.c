@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/dcache.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+
+#include "unittests-constants.h"
+#include "tests-ipv6_dcache.h"
+
+#define TEST_NETIF      (TEST_UINT16)
+#define TEST_L2ADDR     { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 }
+/* a link-local destination */
+#define TEST_DST        { { \
+            0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 \
+        } \
+    }
+/* a link-local source address of TEST_NETIF */
+#define TEST_SRC        { { \
+            0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 \
+        } \
+    }
+
+static const uint8_t l2addr[] = TEST_L2ADDR;
+
+static void set_up(void)
+{
+    ipv6_addr_t src = TEST_SRC;
+
+    gnrc_ipv6_netif_init();
+    gnrc_ipv6_nc_init();
+    fib_init(&gnrc_ipv6_fib_table);
+    gnrc_ipv6_netif_add(TEST_NETIF);
+    gnrc_ipv6_netif_add_addr(TEST_NETIF, &src, 64, GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+    gnrc_ipv6_dcache_flush();
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_nc_init();
+    gnrc_ipv6_netif_init();
+}
+
+/* adds dst after it missed like gnrc_ipv6 does, NULL if it did not miss */
+static gnrc_ipv6_dcache_t *_resolve(kernel_pid_t iface, const ipv6_addr_t *dst)
+{
+    if (gnrc_ipv6_dcache_get(iface, dst) != NULL) {
+        return NULL;
+    }
+    return gnrc_ipv6_dcache_add(iface, dst, TEST_NETIF, l2addr, sizeof(l2addr));
+}
+
+static void test_ipv6_dcache_get__empty(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get_next(NULL));
+}
+
+static void test_ipv6_dcache_add__l2addr_too_long(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_add(KERNEL_PID_UNDEF, &dst, TEST_NETIF, l2addr,
+                                          GNRC_IPV6_NC_L2_ADDR_MAX + 1));
+}
+
+static void test_ipv6_dcache_add__success(void)
+{
+    ipv6_addr_t dst = TEST_DST, src = TEST_SRC;
+    gnrc_ipv6_dcache_t *entry;
+
+    TEST_ASSERT_NOT_NULL((entry = _resolve(KERNEL_PID_UNDEF, &dst)));
+    TEST_ASSERT(entry == gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT(ipv6_addr_equal(&dst, &entry->dst));
+    TEST_ASSERT(ipv6_addr_equal(&src, &entry->src));
+    TEST_ASSERT_EQUAL_INT(TEST_NETIF, entry->iface);
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NETIF_DEFAULT_MTU, entry->mtu);
+    TEST_ASSERT_EQUAL_INT(sizeof(l2addr), entry->l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(l2addr, entry->l2addr, sizeof(l2addr)));
+    TEST_ASSERT(entry == gnrc_ipv6_dcache_get_next(NULL));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get_next(entry));
+}
+
+static void test_ipv6_dcache_get__other_iface(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_resolve(TEST_NETIF, &dst));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_get(TEST_NETIF, &dst));
+}
+
+static void test_ipv6_dcache_get__other_dst(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    dst.u8[15]++;
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dcache_flush(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_dcache_flush();
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get_next(NULL));
+}
+
+static void test_ipv6_dcache_flush__before_add(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    /* the cache was flushed while the next hop was looked up */
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_dcache_flush();
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_add(KERNEL_PID_UNDEF, &dst, TEST_NETIF,
+                                              l2addr, sizeof(l2addr)));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dcache_invalidate__nc(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(TEST_NETIF, &dst, l2addr, sizeof(l2addr),
+                                          GNRC_IPV6_NC_STATE_REACHABLE));
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_nc_remove(TEST_NETIF, &dst);
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dcache_invalidate__netif_addr(void)
+{
+    ipv6_addr_t dst = TEST_DST, src = TEST_SRC;
+
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_netif_remove_addr(TEST_NETIF, &src);
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dcache_invalidate__fib(void)
+{
+    ipv6_addr_t dst = TEST_DST, prefix = TEST_DST;
+
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    prefix.u8[0] = 0x20;
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&gnrc_ipv6_fib_table, TEST_NETIF,
+                                           prefix.u8, sizeof(prefix), 0,
+                                           dst.u8, sizeof(dst), 0,
+                                           (uint32_t)FIB_LIFETIME_NO_EXPIRE));
+    TEST_ASSERT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+}
+
+static void test_ipv6_dcache_get_stats(void)
+{
+    ipv6_addr_t dst = TEST_DST;
+    gnrc_ipv6_dcache_stats_t before, after;
+
+    gnrc_ipv6_dcache_get_stats(&before);
+    TEST_ASSERT_NOT_NULL(_resolve(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_dcache_get(KERNEL_PID_UNDEF, &dst));
+    gnrc_ipv6_dcache_flush();
+    gnrc_ipv6_dcache_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(2, after.hits - before.hits);
+    TEST_ASSERT_EQUAL_INT(1, after.misses - before.misses);
+    TEST_ASSERT_EQUAL_INT(1, after.flushes - before.flushes);
+}
+
+Test *tests_ipv6_dcache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_dcache_get__empty),
+        new_TestFixture(test_ipv6_dcache_add__l2addr_too_long),
+        new_TestFixture(test_ipv6_dcache_add__success),
+        new_TestFixture(test_ipv6_dcache_get__other_iface),
+        new_TestFixture(test_ipv6_dcache_get__other_dst),
+        new_TestFixture(test_ipv6_dcache_flush),
+        new_TestFixture(test_ipv6_dcache_flush__before_add),
+        new_TestFixture(test_ipv6_dcache_invalidate__nc),
+        new_TestFixture(test_ipv6_dcache_invalidate__netif_addr),
+        new_TestFixture(test_ipv6_dcache_invalidate__fib),
+        new_TestFixture(test_ipv6_dcache_get_stats),
+    };
+
+    EMB_UNIT_TESTCALLER(ipv6_dcache_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&ipv6_dcache_tests;
+}
+
+void tests_ipv6_dcache(void)
+{
+    TESTS_RUN(tests_ipv6_dcache_tests());
+}
+/** @} */
@@ -108,14 +108,73 @@ static void test_ipv6_nc_add__full(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
 
+    gnrc_ipv6_nc_stats_t stats;
+
+    /* reachable entries must not be evicted */
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
-                                              sizeof(TEST_STRING4), 0));
+                                              sizeof(TEST_STRING4),
+                                              GNRC_IPV6_NC_STATE_REACHABLE));
         addr.u16[7].u16++;
     }
 
     TEST_ASSERT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
                                       sizeof(TEST_STRING4), 0));
+    gnrc_ipv6_nc_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.evictions);
+    TEST_ASSERT_EQUAL_INT(1, stats.full);
+}
+
+static void test_ipv6_nc_add__full_evict_lru(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR, second = DEFAULT_TEST_IPV6_ADDR;
+    gnrc_ipv6_nc_stats_t stats;
+
+    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4),
+                                              GNRC_IPV6_NC_STATE_STALE));
+        addr.u16[7].u16++;
+    }
+    second.u16[7].u16++;
+
+    /* the oldest entry was used recently, so the second one is replaced */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
+
+    gnrc_ipv6_nc_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_NC_SIZE, stats.entries);
+    TEST_ASSERT_EQUAL_INT(1, stats.evictions);
+    TEST_ASSERT_EQUAL_INT(0, stats.full);
+}
+
+static void test_ipv6_nc_add__full_skip_router(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR, second = DEFAULT_TEST_IPV6_ADDR;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4),
+                                          GNRC_IPV6_NC_STATE_STALE |
+                                          GNRC_IPV6_NC_IS_ROUTER));
+    addr.u16[7].u16++;
+    for (int i = 1; i < GNRC_IPV6_NC_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                              sizeof(TEST_STRING4),
+                                              GNRC_IPV6_NC_STATE_STALE));
+        addr.u16[7].u16++;
+    }
+    second.u16[7].u16++;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr, TEST_STRING4,
+                                          sizeof(TEST_STRING4), 0));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &first));
+    TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &second));
 }
 
 static void test_ipv6_nc_add__success(void)
@@ -440,6 +499,32 @@ static void test_ipv6_nc_get_l2_addr__reachable(void)
     TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING4), l2_addr_len);
 }
 
+static void test_ipv6_nc_get_stats(void)
+{
+    ipv6_addr_t addr1 = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t addr2 = OTHER_TEST_IPV6_ADDR;
+    ipv6_addr_t addr3 = THIRD_TEST_IPV6_ADDR;
+    gnrc_ipv6_nc_stats_t stats;
+
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr1, NULL, 0,
+                                          GNRC_IPV6_NC_STATE_INCOMPLETE));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr2, TEST_STRING4,
+                                          sizeof(TEST_STRING4),
+                                          GNRC_IPV6_NC_STATE_STALE));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr3, TEST_STRING4,
+                                          sizeof(TEST_STRING4),
+                                          GNRC_IPV6_NC_STATE_STALE));
+    gnrc_ipv6_nc_remove(DEFAULT_TEST_NETIF, &addr3);
+
+    gnrc_ipv6_nc_get_stats(&stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.entries);
+    TEST_ASSERT_EQUAL_INT(1, stats.states[GNRC_IPV6_NC_STATE_INCOMPLETE]);
+    TEST_ASSERT_EQUAL_INT(1, stats.states[GNRC_IPV6_NC_STATE_STALE]);
+    TEST_ASSERT_EQUAL_INT(0, stats.states[GNRC_IPV6_NC_STATE_REACHABLE]);
+    TEST_ASSERT_EQUAL_INT(0, stats.evictions);
+    TEST_ASSERT_EQUAL_INT(0, stats.full);
+}
+
 Test *tests_ipv6_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -449,6 +534,8 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_add__addr_unspecified),
         new_TestFixture(test_ipv6_nc_add__l2addr_too_long),
         new_TestFixture(test_ipv6_nc_add__full),
+        new_TestFixture(test_ipv6_nc_add__full_evict_lru),
+        new_TestFixture(test_ipv6_nc_add__full_skip_router),
         new_TestFixture(test_ipv6_nc_add__success),
         new_TestFixture(test_ipv6_nc_add__address_update_despite_free_entry),
         new_TestFixture(test_ipv6_nc_remove__no_entry_pid),
@@ -475,6 +562,7 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_get_l2_addr__NULL_entry),
         new_TestFixture(test_ipv6_nc_get_l2_addr__unreachable),
         new_TestFixture(test_ipv6_nc_get_l2_addr__reachable),
+        new_TestFixture(test_ipv6_nc_get_stats),
     };
 
     EMB_UNIT_TESTCALLER(ipv6_nc_tests, set_up, tear_down, fixtures);
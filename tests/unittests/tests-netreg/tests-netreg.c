@@ -21,11 +21,15 @@
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+#define MANY_NUMOF      (256U)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+static gnrc_netreg_entry_t many[MANY_NUMOF];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +143,62 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+/* registers n entries with demux contexts base, base + 1, ... */
+static void _register_many(unsigned n, uint32_t base)
+{
+    for (unsigned i = 0; i < n; i++) {
+        gnrc_netreg_entry_init_pid(&many[i], base + i, TEST_UINT8);
+        TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &many[i]));
+    }
+}
+
+void test_netreg_lookup__many(void)
+{
+    _register_many(MANY_NUMOF, TEST_UINT16);
+    for (unsigned i = 0; i < MANY_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+
+        TEST_ASSERT(res == &many[i]);
+        TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16 + i));
+    }
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16 + MANY_NUMOF));
+    TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, GNRC_NETREG_DEMUX_CTX_ALL));
+}
+
+void test_netreg_getnext__many(void)
+{
+    gnrc_netreg_entry_t *res;
+
+    /* entries of other contexts in the same bucket must be skipped */
+    _register_many(MANY_NUMOF, TEST_UINT16);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(3, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT(res == &entries[1]);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT(res == &entries[0]);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT(res == &many[0]);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+}
+
+void test_netreg_unregister__many(void)
+{
+    _register_many(MANY_NUMOF, TEST_UINT16);
+    for (unsigned i = 0; i < MANY_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[i]);
+    }
+    for (unsigned i = 0; i < MANY_NUMOF; i++) {
+        gnrc_netreg_entry_t *res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                      TEST_UINT16 + i);
+
+        TEST_ASSERT((i & 1) ? (res == &many[i]) : (res == NULL));
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +215,9 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__many),
+        new_TestFixture(test_netreg_getnext__many),
+        new_TestFixture(test_netreg_unregister__many),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -274,6 +274,150 @@ static void test_pktbuf_add__0_sized_release(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_add_headroom__success(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                   sizeof(TEST_STRING16), 16,
+                                                   GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, pkt->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING16), pkt->size);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TEST, pkt->type);
+    TEST_ASSERT_EQUAL_INT(1, pkt->users);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_headroom__memfull(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add_headroom(NULL, NULL, GNRC_PKTBUF_SIZE - 8,
+                                              16, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_headroom__size_0(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_headroom(NULL, NULL, 0, 16,
+                                                   GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend__pkt_NULL(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_prepend(NULL, sizeof(TEST_STRING8),
+                                              GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(pkt->next);
+    TEST_ASSERT_NOT_NULL(pkt->data);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING8), pkt->size);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend__in_headroom(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       12, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr1, *hdr2;
+
+    TEST_ASSERT_NOT_NULL(payload);
+    hdr1 = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr1);
+    TEST_ASSERT(hdr1->next == payload);
+    TEST_ASSERT(((uint8_t *)hdr1->data) + 8 == payload->data);
+    TEST_ASSERT_EQUAL_INT(8, hdr1->size);
+    TEST_ASSERT_EQUAL_INT(1, hdr1->users);
+    hdr2 = gnrc_pktbuf_prepend(hdr1, 4, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(hdr2->next == hdr1);
+    TEST_ASSERT(((uint8_t *)hdr2->data) + 4 == hdr1->data);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, payload->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend__headroom_too_small(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       4, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr1, *hdr2;
+
+    TEST_ASSERT_NOT_NULL(payload);
+    hdr1 = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr1);
+    TEST_ASSERT(hdr1->next == payload);
+    TEST_ASSERT(((uint8_t *)hdr1->data) + 8 != payload->data);
+    TEST_ASSERT_EQUAL_INT(8, hdr1->size);
+    /* headroom was not used by hdr1, but it is not in front of hdr1 either */
+    hdr2 = gnrc_pktbuf_prepend(hdr1, 4, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(((uint8_t *)hdr2->data) + 4 != hdr1->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend__shared(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       16, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr1, *hdr2;
+
+    TEST_ASSERT_NOT_NULL(payload);
+    gnrc_pktbuf_hold(payload, 1);
+    hdr1 = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr1);
+    TEST_ASSERT(((uint8_t *)hdr1->data) + 8 == payload->data);
+    /* the space directly in front of payload is already claimed by hdr1 */
+    hdr2 = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(hdr2->next == payload);
+    TEST_ASSERT(hdr2->data != hdr1->data);
+    TEST_ASSERT(((uint8_t *)hdr2->data) + 8 != payload->data);
+    gnrc_pktbuf_release(hdr1);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    gnrc_pktbuf_release(hdr2);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_prepend__released(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       8, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(payload);
+    gnrc_pktbuf_hold(payload, 1);
+    /* e.g. a lower layer retrying to send the payload */
+    for (unsigned i = 0; i < 4; i++) {
+        gnrc_pktsnip_t *hdr = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+
+        TEST_ASSERT_NOT_NULL(hdr);
+        TEST_ASSERT(((uint8_t *)hdr->data) + 8 == payload->data);
+        gnrc_pktbuf_hold(payload, 1);
+        gnrc_pktbuf_release(hdr);
+        TEST_ASSERT(gnrc_pktbuf_is_sane());
+    }
+    gnrc_pktbuf_release(payload);
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    gnrc_pktbuf_release(payload);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_mark__pkt_NULL__size_0(void)
 {
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(NULL, 0, GNRC_NETTYPE_TEST));
@@ -317,7 +461,8 @@ static void test_pktbuf_mark__pkt_NOT_NULL__size_greater_than_pkt_size(void)
 
 static void test_pktbuf_mark__pkt_NOT_NULL__pkt_data_NULL(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, NULL, sizeof(TEST_STRING16), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .next = NULL, .data = NULL,
+                           .size = sizeof(TEST_STRING16), .type = GNRC_NETTYPE_TEST };
 
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(&pkt, sizeof(TEST_STRING16) - 1,
                                       GNRC_NETTYPE_TEST));
@@ -647,6 +792,31 @@ static void test_pktbuf_realloc_data__success3(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_realloc_data__prepended(void)
+{
+    gnrc_pktsnip_t *payload = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                       sizeof(TEST_STRING16),
+                                                       16, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(payload);
+    hdr = gnrc_pktbuf_prepend(payload, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    memcpy(hdr->data, TEST_STRING8, 8);
+    /* shrinking keeps the data in the headroom */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 4));
+    TEST_ASSERT(((uint8_t *)hdr->data) + 8 == payload->data);
+    TEST_ASSERT_EQUAL_INT(4, hdr->size);
+    /* growing moves it out */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(hdr, 32));
+    TEST_ASSERT_EQUAL_INT(32, hdr->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING8, hdr->data, 4));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING16, payload->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_hold__pkt_null(void)
 {
     gnrc_pktbuf_hold(NULL, 1);
@@ -655,7 +825,8 @@ static void test_pktbuf_hold__pkt_null(void)
 
 static void test_pktbuf_hold__pkt_external(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .next = NULL, .data = TEST_STRING8,
+                           .size = sizeof(TEST_STRING8), .type = GNRC_NETTYPE_TEST };
 
     gnrc_pktbuf_hold(&pkt, 1);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -801,6 +972,32 @@ static void test_pktbuf_get_iovec__3_elem(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_get_iovec__prepended(void)
+{
+    struct iovec *vec;
+    size_t len;
+    gnrc_pktsnip_t *snip = gnrc_pktbuf_add_headroom(NULL, TEST_STRING16,
+                                                    sizeof(TEST_STRING16), 16,
+                                                    GNRC_NETTYPE_UNDEF);
+    snip = gnrc_pktbuf_prepend(snip, 8, GNRC_NETTYPE_UNDEF);
+    snip = gnrc_pktbuf_prepend(snip, 8, GNRC_NETTYPE_UNDEF);
+    /* e.g. netif header */
+    snip = gnrc_pktbuf_add(snip, TEST_STRING4, sizeof(TEST_STRING4),
+                           GNRC_NETTYPE_UNDEF);
+    snip = gnrc_pktbuf_get_iovec(snip, &len);
+    vec = (struct iovec *)snip->data;
+
+    TEST_ASSERT_EQUAL_INT((sizeof(struct iovec) * 2), snip->size);
+    TEST_ASSERT_EQUAL_INT(2, len);
+    TEST_ASSERT(snip->next->data == vec[0].iov_base);
+    TEST_ASSERT(snip->next->next->data == vec[1].iov_base);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING4), vec[0].iov_len);
+    TEST_ASSERT_EQUAL_INT(8 + 8 + sizeof(TEST_STRING16), vec[1].iov_len);
+
+    gnrc_pktbuf_release(snip);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_get_iovec__null(void)
 {
     gnrc_pktsnip_t *res;
@@ -828,6 +1025,14 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__packed_struct),
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
         new_TestFixture(test_pktbuf_add__0_sized_release),
+        new_TestFixture(test_pktbuf_add_headroom__success),
+        new_TestFixture(test_pktbuf_add_headroom__memfull),
+        new_TestFixture(test_pktbuf_add_headroom__size_0),
+        new_TestFixture(test_pktbuf_prepend__pkt_NULL),
+        new_TestFixture(test_pktbuf_prepend__in_headroom),
+        new_TestFixture(test_pktbuf_prepend__headroom_too_small),
+        new_TestFixture(test_pktbuf_prepend__shared),
+        new_TestFixture(test_pktbuf_prepend__released),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_not_0),
         new_TestFixture(test_pktbuf_mark__pkt_NOT_NULL__size_0),
@@ -846,6 +1051,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_realloc_data__success),
         new_TestFixture(test_pktbuf_realloc_data__success2),
         new_TestFixture(test_pktbuf_realloc_data__success3),
+        new_TestFixture(test_pktbuf_realloc_data__prepended),
         new_TestFixture(test_pktbuf_hold__pkt_null),
         new_TestFixture(test_pktbuf_hold__pkt_external),
         new_TestFixture(test_pktbuf_hold__success),
@@ -857,6 +1063,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
+        new_TestFixture(test_pktbuf_get_iovec__prepended),
         new_TestFixture(test_pktbuf_get_iovec__null),
     };
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "universal_address.h"
+
+#include "tests-universal_address.h"
+
+static uint8_t addr_a[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                              0, 0, 0, 0, 0, 0, 0, 0x01 };
+static uint8_t addr_b[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                              0, 0, 0, 0, 0, 0, 0, 0x02 };
+static uint8_t addr_zero[16];
+
+static void set_up(void)
+{
+    universal_address_init();
+}
+
+static void _addr(uint8_t *addr, unsigned i)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0xfe;
+    addr[1] = 0x80;
+    addr[12] = (uint8_t)(i >> 8);
+    addr[13] = (uint8_t)i;
+    addr[15] = (uint8_t)(i * 7);
+}
+
+static void test_universal_address_add__same(void)
+{
+    universal_address_container_t *a, *b;
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    TEST_ASSERT_NOT_NULL(a);
+    b = universal_address_add(addr_a, sizeof(addr_a));
+    TEST_ASSERT(a == b);
+    TEST_ASSERT_EQUAL_INT(2, a->use_count);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__distinct(void)
+{
+    universal_address_container_t *a, *b, *c;
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    b = universal_address_add(addr_b, sizeof(addr_b));
+    /* the same bytes with another size are another address */
+    c = universal_address_add(addr_a, 8);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT(a != b);
+    TEST_ASSERT(a != c);
+    TEST_ASSERT(b != c);
+    TEST_ASSERT_EQUAL_INT(8, c->address_size);
+    TEST_ASSERT_EQUAL_INT(3, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__too_long(void)
+{
+    uint8_t addr[UNIVERSAL_ADDRESS_SIZE + 1] = { 0 };
+
+    TEST_ASSERT_NULL(universal_address_add(addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_add__full(void)
+{
+    universal_address_container_t *first = NULL;
+    uint8_t addr[16];
+
+    for (unsigned i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; i++) {
+        universal_address_container_t *entry;
+
+        _addr(addr, i);
+        entry = universal_address_add(addr, sizeof(addr));
+        TEST_ASSERT_NOT_NULL(entry);
+        if (i == 0) {
+            first = entry;
+        }
+    }
+    TEST_ASSERT_NULL(universal_address_add(addr_a, sizeof(addr_a)));
+    /* existing addresses can still be referenced */
+    _addr(addr, 0);
+    TEST_ASSERT(first == universal_address_add(addr, sizeof(addr)));
+    universal_address_rem(first);
+    universal_address_rem(first);
+    TEST_ASSERT_NOT_NULL(universal_address_add(addr_a, sizeof(addr_a)));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MAX_ENTRIES,
+                          universal_address_get_num_used_entries());
+}
+
+static void test_universal_address_rem(void)
+{
+    universal_address_container_t *a, *b;
+    uint8_t addr[16];
+    size_t addr_size = sizeof(addr);
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    b = universal_address_add(addr_b, sizeof(addr_b));
+    universal_address_add(addr_a, sizeof(addr_a));
+    universal_address_rem(a);
+    TEST_ASSERT_EQUAL_INT(2, universal_address_get_num_used_entries());
+    universal_address_rem(a);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+    /* removing more often than added must not underflow */
+    universal_address_rem(a);
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+
+    /* the remaining address is still found */
+    TEST_ASSERT(b == universal_address_add(addr_b, sizeof(addr_b)));
+    TEST_ASSERT_EQUAL_INT(2, b->use_count);
+    TEST_ASSERT(universal_address_get_address(b, addr, &addr_size) == addr);
+    TEST_ASSERT_EQUAL_INT(sizeof(addr_b), addr_size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(addr, addr_b, sizeof(addr_b)));
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_INT(1, a->use_count);
+}
+
+static void test_universal_address_compare(void)
+{
+    universal_address_container_t *a, *zero;
+    size_t bits = 128;
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    zero = universal_address_add(addr_zero, sizeof(addr_zero));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare(a, addr_a, &bits));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare(a, addr_b, &bits));
+    bits = 128;
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS,
+                          universal_address_compare(zero, addr_a, &bits));
+    TEST_ASSERT_EQUAL_INT(0, bits);
+    bits = 64;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, universal_address_compare(a, addr_a, &bits));
+}
+
+static void test_universal_address_compare_prefix(void)
+{
+    uint8_t prefix[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t other[16] = { 0x20, 0x01, 0x0d, 0xb9 };
+    universal_address_container_t *a, *p;
+
+    a = universal_address_add(addr_a, sizeof(addr_a));
+    p = universal_address_add(prefix, sizeof(prefix));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(a, prefix, 128));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare_prefix(p, prefix, 128));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare_prefix(a, addr_a, 128));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(a, other, 128));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(a, addr_b, 128));
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(a, prefix, 64));
+    /* the all zero prefix covers every address */
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(a, addr_zero, 128));
+}
+
+Test *tests_universal_address_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_universal_address_add__same),
+        new_TestFixture(test_universal_address_add__distinct),
+        new_TestFixture(test_universal_address_add__too_long),
+        new_TestFixture(test_universal_address_add__full),
+        new_TestFixture(test_universal_address_rem),
+        new_TestFixture(test_universal_address_compare),
+        new_TestFixture(test_universal_address_compare_prefix),
+    };
+
+    EMB_UNIT_TESTCALLER(universal_address_tests, set_up, NULL, fixtures);
+
+    return (Test *)&universal_address_tests;
+}
+
+void tests_universal_address(void)
+{
+    TESTS_RUN(tests_universal_address_tests());
+}
+/** @} */
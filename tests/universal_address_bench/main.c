@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark for interning addresses with universal_address
+ *
+ * Fills a pool of n addresses for n = POOL_MIN up to the pool size, then
+ * interns and releases every address in turn, as the FIB does for next hops.
+ * For comparison, the same addresses are also looked up by scanning the
+ * pool, which is how universal_address_add() used to find them.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "universal_address.h"
+#include "xtimer.h"
+
+#define POOL_MIN        (32U)
+#define OPS             (8192U)
+
+static universal_address_container_t scan_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+static void _addr(uint8_t *addr, unsigned i)
+{
+    memset(addr, 0, 16);
+    addr[0] = 0xfe;
+    addr[1] = 0x80;
+    addr[12] = (uint8_t)(i >> 8);
+    addr[13] = (uint8_t)i;
+    addr[15] = (uint8_t)(i * 7);
+}
+
+static universal_address_container_t *_scan_find(unsigned n, uint8_t *addr,
+                                                 size_t addr_size)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (scan_table[i].address_size == addr_size) {
+            if (memcmp((scan_table[i].address), addr, addr_size) == 0) {
+                return &(scan_table[i]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    uint8_t addr[16];
+    unsigned errors = 0;
+
+    printf("universal_address benchmark, %u operations per size\n", OPS);
+    puts("    n | add+rem [ns] | scan [ns]");
+    for (unsigned n = POOL_MIN; n <= UNIVERSAL_ADDRESS_MAX_ENTRIES; n *= 2) {
+        uint32_t start, hashed, scan;
+        unsigned found = 0;
+
+        universal_address_init();
+        for (unsigned i = 0; i < n; i++) {
+            _addr(addr, i);
+            errors += (universal_address_add(addr, sizeof(addr)) == NULL);
+            memcpy(scan_table[i].address, addr, sizeof(addr));
+            scan_table[i].address_size = sizeof(addr);
+        }
+
+        start = xtimer_now();
+        for (unsigned i = 0; i < OPS; i++) {
+            universal_address_container_t *entry;
+
+            _addr(addr, i % n);
+            entry = universal_address_add(addr, sizeof(addr));
+            found += (entry != NULL);
+            universal_address_rem(entry);
+        }
+        hashed = xtimer_now() - start;
+
+        start = xtimer_now();
+        for (unsigned i = 0; i < OPS; i++) {
+            _addr(addr, i % n);
+            found += (_scan_find(n, addr, sizeof(addr)) != NULL);
+        }
+        scan = xtimer_now() - start;
+
+        printf("%5u | %12" PRIu32 " | %9" PRIu32 "\n", n,
+               (uint32_t)(((uint64_t)hashed * 1000) / OPS),
+               (uint32_t)(((uint64_t)scan * 1000) / OPS));
+        errors += (found != (2 * OPS));
+        errors += (universal_address_get_num_used_entries() != (int)n);
+    }
+
+    if (errors == 0) {
+        puts("[SUCCESS]");
+    }
+    else {
+        printf("[FAILED] %u errors\n", errors);
+    }
+
+    return 0;
+}
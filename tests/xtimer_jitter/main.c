@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    xtimer wakeup latency measurement
+ *
+ * Wakes up periodically with xtimer_periodic_wakeup() and records how late
+ * each wakeup is. For every interval the minimum, average and maximum
+ * latency and a histogram of the latencies in powers of two are printed.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#ifndef SAMPLES
+#define SAMPLES         (1000U)
+#endif
+
+/**
+ * latencies of 2^(BUCKETS - 1) us and more end up in the last bucket
+ */
+#define BUCKETS         (16U)
+
+static const uint32_t intervals[] = { 100, 1000, 10000 };
+
+static unsigned _bucket(uint32_t latency)
+{
+    unsigned bucket = 0;
+
+    while (latency && (bucket < (BUCKETS - 1))) {
+        latency >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void _measure(uint32_t interval)
+{
+    unsigned hist[BUCKETS] = { 0 };
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t sum = 0;
+    uint32_t last = xtimer_now();
+
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        xtimer_periodic_wakeup(&last, interval);
+        /* last now holds the time the wakeup was due */
+        uint32_t latency = xtimer_now() - last;
+
+        if (latency < min) {
+            min = latency;
+        }
+        if (latency > max) {
+            max = latency;
+        }
+        sum += latency;
+        hist[_bucket(latency)]++;
+    }
+
+    printf("interval %" PRIu32 " us: min %" PRIu32 " us, avg %" PRIu32
+           " us, max %" PRIu32 " us\n", interval, min,
+           (uint32_t)(sum / SAMPLES), max);
+
+    for (unsigned i = 0; i < BUCKETS; i++) {
+        if (hist[i]) {
+            /* bucket i holds latencies in [2^(i-1), 2^i) */
+            printf("  < %6lu us: %u\n", 1LU << i, hist[i]);
+        }
+    }
+}
+
+int main(void)
+{
+    puts("xtimer jitter test");
+
+    for (unsigned i = 0; i < sizeof(intervals) / sizeof(intervals[0]); i++) {
+        _measure(intervals[i]);
+    }
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
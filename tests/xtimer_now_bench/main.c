@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    Measures the cost of reading the xtimer clocks
+ *
+ * Calls xtimer_now(), xtimer_now64() and xtimer_now64_coarse() in a loop
+ * and prints the average time per call. Also checks that xtimer_now64()
+ * never goes backwards and that the coarse time does not lag by more than
+ * XTIMER_COARSE_TICK.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#ifndef ITERATIONS
+#define ITERATIONS      (100000UL)
+#endif
+
+/**
+ * @brief   lag of the coarse time tolerated on top of XTIMER_COARSE_TICK
+ */
+#define COARSE_SLACK    (1000U)
+
+static volatile uint64_t sink;
+
+static void _print(const char *name, uint32_t start)
+{
+    uint32_t diff = xtimer_now() - start;
+
+    printf("%-22s %6" PRIu32 " ns/call\n", name,
+           (uint32_t)(((uint64_t)diff * 1000) / ITERATIONS));
+}
+
+int main(void)
+{
+    uint32_t start;
+    int res = 0;
+
+    puts("xtimer clock read benchmark");
+
+    start = xtimer_now();
+    for (unsigned long i = 0; i < ITERATIONS; i++) {
+        sink = xtimer_now();
+    }
+    _print("xtimer_now()", start);
+
+    start = xtimer_now();
+    for (unsigned long i = 0; i < ITERATIONS; i++) {
+        sink = xtimer_now64();
+    }
+    _print("xtimer_now64()", start);
+
+    start = xtimer_now();
+    for (unsigned long i = 0; i < ITERATIONS; i++) {
+        sink = xtimer_now64_coarse();
+    }
+    _print("xtimer_now64_coarse()", start);
+
+    uint64_t last = xtimer_now64();
+    uint64_t max_lag = 0;
+    for (unsigned long i = 0; i < ITERATIONS; i++) {
+        uint64_t coarse = xtimer_now64_coarse();
+        uint64_t now = xtimer_now64();
+
+        if (now < last) {
+            puts("error: xtimer_now64() went backwards");
+            res = -1;
+            break;
+        }
+        last = now;
+
+        if ((now - coarse) > max_lag) {
+            max_lag = now - coarse;
+        }
+    }
+
+    printf("max coarse lag: %" PRIu32 " us\n", (uint32_t)max_lag);
+#if XTIMER_COARSE_TICK
+    if (max_lag > (XTIMER_COARSE_TICK + COARSE_SLACK)) {
+        puts("error: coarse time lags too much");
+        res = -1;
+    }
+#endif
+
+    puts(res ? "[FAILURE]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    xtimer set and remove benchmark
+ *
+ * Arms TIMER_NUMOF timers with pseudo random offsets between one and eleven
+ * seconds and cancels them again, and prints the average time per
+ * xtimer_set() and xtimer_remove(). Build with XTIMER_WHEEL=0 to compare the
+ * timing wheel with the sorted list backend.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#ifndef TIMER_NUMOF
+#define TIMER_NUMOF     (1000U)
+#endif
+
+#define RUNS            (10U)
+
+static xtimer_t timers[TIMER_NUMOF];
+static uint32_t offsets[TIMER_NUMOF];
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("error: timer fired");
+}
+
+int main(void)
+{
+    uint32_t seed = 1;
+    uint32_t set_time = 0, remove_time = 0, start;
+
+#ifdef MODULE_XTIMER_WHEEL
+    puts("xtimer set/remove benchmark (timing wheel)");
+#else
+    puts("xtimer set/remove benchmark (sorted lists)");
+#endif
+
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        /* simple LCG, the offsets only need to be spread */
+        seed = (seed * 1103515245) + 12345;
+        offsets[i] = SEC_IN_USEC + ((seed >> 8) % (10U * SEC_IN_USEC));
+        timers[i].callback = _cb;
+    }
+
+    for (unsigned run = 0; run < RUNS; run++) {
+        start = xtimer_now();
+        for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+            xtimer_set(&timers[i], offsets[i]);
+        }
+        set_time += xtimer_now() - start;
+
+        /* cancel in a different order than the timers were set */
+        start = xtimer_now();
+        for (unsigned i = 0; i < TIMER_NUMOF; i += 2) {
+            xtimer_remove(&timers[i]);
+        }
+        for (unsigned i = 1; i < TIMER_NUMOF; i += 2) {
+            xtimer_remove(&timers[i]);
+        }
+        remove_time += xtimer_now() - start;
+    }
+
+    printf("%u timers: set %" PRIu32 " ns, remove %" PRIu32 " ns per timer\n",
+           TIMER_NUMOF,
+           (uint32_t)(((uint64_t)set_time * 1000) / (RUNS * TIMER_NUMOF)),
+           (uint32_t)(((uint64_t)remove_time * 1000) / (RUNS * TIMER_NUMOF)));
+
+    puts("[SUCCESS]");
+
+    return 0;
+}
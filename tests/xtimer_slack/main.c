@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief    xtimer_set_slack() test
+ *
+ * Sets TIMER_NUMOF timers spread over one second, first without and then
+ * with slack, checks that every timer fires within its window and prints
+ * how many low-level timer wakeups were needed and saved.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#ifndef TIMER_NUMOF
+#define TIMER_NUMOF     (64U)
+#endif
+
+#define SPREAD          (1000000U)
+
+/**
+ * @brief   time a timer may fire late beyond its slack, e.g., due to other
+ *          timers firing at the same time
+ */
+#define TOLERANCE       (1000U)
+
+static xtimer_t timers[TIMER_NUMOF];
+static uint32_t targets[TIMER_NUMOF];
+static volatile uint32_t fired_at[TIMER_NUMOF];
+
+static const uint32_t slacks[] = { 0, 1000, 10000, 100000 };
+
+static void _cb(void *arg)
+{
+    fired_at[(uintptr_t)arg] = xtimer_now();
+}
+
+static int _run(uint32_t slack)
+{
+    uint32_t seed = 1;
+    int res = 0;
+
+    memset(&xtimer_stats, 0, sizeof(xtimer_stats));
+    memset((void *)fired_at, 0, sizeof(fired_at));
+
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        seed = (seed * 1103515245) + 12345;
+        uint32_t offset = 1000 + ((seed >> 8) % SPREAD);
+
+        timers[i].callback = _cb;
+        timers[i].arg = (void *)(uintptr_t)i;
+        targets[i] = xtimer_now() + offset;
+        xtimer_set_slack(&timers[i], offset, slack);
+    }
+
+    xtimer_usleep(SPREAD + slack + 100000);
+
+    for (unsigned i = 0; i < TIMER_NUMOF; i++) {
+        int32_t late = (int32_t)(fired_at[i] - targets[i]);
+
+        if (!fired_at[i] || (late < 0) || ((uint32_t)late > slack + TOLERANCE)) {
+            printf("error: timer %u fired %" PRIi32 " us late\n", i, late);
+            res = -1;
+        }
+    }
+
+    printf("slack %6" PRIu32 " us: %" PRIu32 " timers, %" PRIu32 " wakeups, "
+           "%" PRIu32 " saved (%" PRIu32 " targets moved)\n", slack,
+           xtimer_stats.fired, xtimer_stats.wakeups,
+           xtimer_stats.fired - xtimer_stats.wakeups, xtimer_stats.slack_moved);
+
+    return res;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("xtimer slack test");
+
+    for (unsigned i = 0; i < sizeof(slacks) / sizeof(slacks[0]); i++) {
+        res |= _run(slacks[i]);
+    }
+
+    puts(res ? "[FAILURE]" : "[SUCCESS]");
+
+    return 0;
+}